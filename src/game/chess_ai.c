@@ -1,17 +1,122 @@
 /**
  * @file chess_ai.c
- * @brief AI 选步入口：按难度调用 Easy / Medium
+ * @brief AI 选步入口：按难度调用 Easy / Medium；Medium 先以小预算找杀（chess_mate.c）。
+ *        选步是可分片的任务（eng->job），一次算完的 chess_ai_pick_move 只是连续调用 step。
  */
 
 #include "chess_state.h"
 #include "chess_move.h"
 #include "chess_ai.h"
+#include "chess_search.h"
+#include "chess_mate.h"
+#include "chess_engine.h"
+#include "game_clock.h"
 
-extern int chess_ai_pick_move_easy(const ChessBoardState *state, ChessMove *out);
-extern int chess_ai_pick_move_medium(const ChessBoardState *state, ChessMove *out);
+extern int chess_ai_pick_move_easy(ChessEngine *eng, const ChessBoardState *state, ChessMove *out, ChessSearchStats *stats);
+extern int chess_ai_medium_begin(ChessEngine *eng, const ChessBoardState *state);
+extern int chess_ai_medium_step(ChessEngine *eng, const ChessBoardState *state, uint32_t budget_us,
+                                ChessMove *out, ChessSearchStats *stats);
+extern void chess_ai_medium_ponder_start(ChessEngine *eng, const ChessBoardState *state);
+extern int chess_ai_medium_ponder_slice(ChessEngine *eng, uint32_t budget_ms, int (*poll)(void *user), void *user);
 
-int chess_ai_pick_move(const ChessBoardState *state, ChessAiDifficulty difficulty, ChessMove *out) {
-    if (difficulty == CHESS_AI_EASY)
-        return chess_ai_pick_move_easy(state, out);
-    return chess_ai_pick_move_medium(state, out);
+/* Medium 正常搜索前先以小预算找杀（步数、节点上限） */
+#define CHESS_AI_MATE_MOVES 3
+#define CHESS_AI_MATE_NODES 3000
+
+enum { AI_IDLE, AI_MATE, AI_SEARCH, AI_DONE };
+
+void chess_ai_begin(ChessEngine *eng, const ChessBoardState *state, ChessAiDifficulty difficulty) {
+    ChessAiJob *job = &eng->job;
+    eng->abort = 0;             /* 复盘分析被 B/X 中止后会留下 1 */
+    chess_search_stats_clear(&eng->last_stats);
+    job->state = *state;
+    job->difficulty = difficulty;
+    job->elapsed_us = 0;
+    job->has_move = 0;
+    if (difficulty == CHESS_AI_EASY) {
+        job->phase = AI_SEARCH;
+        return;
+    }
+    ChessSearchLimits limits;
+    chess_search_limits_init(&limits);
+    limits.depth = CHESS_AI_MATE_MOVES;
+    limits.nodes = CHESS_AI_MATE_NODES;
+    limits.stats = &eng->last_stats;
+    chess_mate_begin(eng, &job->mate, state, &limits);
+    job->phase = AI_MATE;
+}
+
+/* 本片剩余预算；已用完返回 0 且 *expired 置 1 */
+static uint32_t budget_left(uint64_t deadline, int *expired) {
+    if (!deadline) return 0;
+    uint64_t now = game_clock_us();
+    if (now >= deadline) { *expired = 1; return 0; }
+    return (uint32_t)(deadline - now);
+}
+
+int chess_ai_step(ChessEngine *eng, uint32_t budget_us) {
+    ChessAiJob *job = &eng->job;
+    if (job->phase == AI_IDLE || job->phase == AI_DONE) return 1;
+    uint64_t t0 = game_clock_us();
+    uint64_t deadline = budget_us ? t0 + budget_us : 0;
+    int expired = 0;
+
+    if (job->phase == AI_MATE) {
+        /* 找到杀则直接走杀着 */
+        if (chess_mate_step(eng, &job->mate, budget_us)) {
+            if (job->mate.result.found) {
+                job->move = job->mate.result.best;
+                job->has_move = 1;
+                eng->ponder.active = 0;
+                job->phase = AI_DONE;
+            } else {
+                job->phase = chess_ai_medium_begin(eng, &job->state) ? AI_SEARCH : AI_DONE;
+            }
+        }
+    }
+    if (job->phase == AI_SEARCH) {
+        if (job->difficulty == CHESS_AI_EASY) {
+            job->has_move = chess_ai_pick_move_easy(eng, &job->state, &job->move, &eng->last_stats);
+            job->phase = AI_DONE;
+        } else {
+            uint32_t left = budget_left(deadline, &expired);
+            if (!expired && chess_ai_medium_step(eng, &job->state, left, &job->move, &eng->last_stats)) {
+                job->has_move = 1;
+                job->phase = AI_DONE;
+            }
+        }
+    }
+
+    job->elapsed_us += (uint32_t)(game_clock_us() - t0);
+    if (job->phase != AI_DONE) return 0;
+    eng->last_stats.elapsed_us = job->elapsed_us;
+    chess_search_stats_finish(&eng->last_stats);
+    return 1;
+}
+
+int chess_ai_result(const ChessEngine *eng, ChessMove *out) {
+    if (eng->job.phase != AI_DONE || !eng->job.has_move) return 0;
+    *out = eng->job.move;
+    return 1;
+}
+
+int chess_ai_pick_move(ChessEngine *eng, const ChessBoardState *state, ChessAiDifficulty difficulty, ChessMove *out) {
+    chess_ai_begin(eng, state, difficulty);
+    chess_ai_step(eng, 0);
+    return chess_ai_result(eng, out);
+}
+
+void chess_ai_last_stats(const ChessEngine *eng, ChessSearchStats *out) {
+    *out = eng->last_stats;
+}
+
+void chess_ai_ponder_start(ChessEngine *eng, const ChessBoardState *state, ChessAiDifficulty difficulty) {
+    eng->ponder.active = 0;
+    eng->abort = 0;
+    if (difficulty == CHESS_AI_MEDIUM)
+        chess_ai_medium_ponder_start(eng, state);
+}
+
+int chess_ai_ponder_slice(ChessEngine *eng, uint32_t budget_ms, int (*poll)(void *user), void *user) {
+    return chess_ai_medium_ponder_slice(eng, budget_ms, poll, user);
 }
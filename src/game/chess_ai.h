@@ -1,20 +1,53 @@
 /**
  * @file chess_ai.h
  * @brief 难度枚举与 AI 选步接口
+ *
+ * 各入口都以 ChessEngine 为第一个参数，状态（置换表、随机数、后台思考进度、统计）全在引擎里，
+ * 不同引擎可并行使用。新对局调用 chess_engine_new_game。
  */
 
 #ifndef PICO_CODE_CHESS_AI_H
 #define PICO_CODE_CHESS_AI_H
 
+#include <stdint.h>
 #include "chess_state.h"
 #include "chess_move.h"
+#include "chess_search.h"
+#include "chess_engine.h"
 
 typedef enum {
     CHESS_AI_EASY = 0,
     CHESS_AI_MEDIUM = 1
 } ChessAiDifficulty;
 
-/** 为当前行棋方选一步：有合法步则写入 *out 并返回 1，否则返回 0 */
-int chess_ai_pick_move(const ChessBoardState *state, ChessAiDifficulty difficulty, ChessMove *out);
+/** 为当前行棋方选一步：有合法步则写入 *out 并返回 1，否则返回 0（一次算完，等同 begin + step(0) + result） */
+int chess_ai_pick_move(ChessEngine *eng, const ChessBoardState *state, ChessAiDifficulty difficulty, ChessMove *out);
+
+/**
+ * 分片选步，供单核主循环与界面交替运行：begin 之后反复调用 chess_ai_step，每次至多约 budget_us 微秒
+ * （超出量为单个搜索节点的耗时；0 = 不限），返回 1 表示已算完，再用 chess_ai_result 取着法。
+ * 搜索不用 C 递归，暂停时状态都在引擎的显式帧栈里。
+ */
+void chess_ai_begin(ChessEngine *eng, const ChessBoardState *state, ChessAiDifficulty difficulty);
+int chess_ai_step(ChessEngine *eng, uint32_t budget_us);
+
+/** 算完后的着法：有合法步写入 *out 并返回 1 */
+int chess_ai_result(const ChessEngine *eng, ChessMove *out);
+
+/** 最近一次选步的搜索统计（elapsed_us 为各片耗时之和，不含片间的界面时间） */
+void chess_ai_last_stats(const ChessEngine *eng, ChessSearchStats *out);
+
+/**
+ * 后台思考（ponder）：AI 走完后、轮到对方时调用。从置换表取上次搜索 PV 中对方的预测着法，
+ * 准备预测局面；之后在空闲时反复调用 chess_ai_ponder_slice。Easy 不做后台思考。
+ */
+void chess_ai_ponder_start(ChessEngine *eng, const ChessBoardState *state, ChessAiDifficulty difficulty);
+
+/**
+ * 做一片后台思考，至多 budget_ms 毫秒；poll 约每毫秒调用一次，返回非 0 即暂停（下次调用原样继续）。
+ * 返回 1 表示已无可做（完成或未开启），0 表示还需后续调用。
+ * 对方走出预测着法时 chess_ai_pick_move 直接复用已算完的结果。
+ */
+int chess_ai_ponder_slice(ChessEngine *eng, uint32_t budget_ms, int (*poll)(void *user), void *user);
 
 #endif /* PICO_CODE_CHESS_AI_H */
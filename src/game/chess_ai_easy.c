@@ -3,22 +3,20 @@
  * @brief 简单 AI：贪心子力评估，等分时随机（完整移植 demo simple_ai.hpp）
  */
 
-#include <stdlib.h>
 #include "chess_state.h"
 #include "chess_move.h"
 #include "chess_result.h"
 #include "chess_eval.h"
+#include "chess_search.h"
+#include "chess_engine.h"
 #include "chess_ai.h"
 
-#if defined(PICO_ON_DEVICE) && defined(LIB_PICO_STDLIB)
-#include "pico/stdlib.h"
-#include "pico/time.h"
-#endif
-
-int chess_ai_pick_move_easy(const ChessBoardState *state, ChessMove *out) {
+int chess_ai_pick_move_easy(ChessEngine *eng, const ChessBoardState *state, ChessMove *out, ChessSearchStats *stats) {
     ChessAllMovesList list;
     chess_all_legal_moves(state, &list);
     if (list.count == 0) return 0;
+    stats->nodes = (uint32_t)list.count;  /* 每步一次走后评估 */
+    stats->depth = 1;
 
     int side = state->side_to_move;
     int best_score = -9999;
@@ -37,16 +35,8 @@ int chess_ai_pick_move_easy(const ChessBoardState *state, ChessMove *out) {
     }
 
     int idx = (best_count > 0) ? best_indices[0] : 0;
-    if (best_count > 1) {
-#if defined(PICO_ON_DEVICE) && defined(LIB_PICO_STDLIB)
-        static int seeded = 0;
-        if (!seeded) {
-            srand((unsigned)(to_us_since_boot(get_absolute_time()) & 0x7FFF));
-            seeded = 1;
-        }
-#endif
-        idx = best_indices[rand() % best_count];
-    }
+    if (best_count > 1)
+        idx = best_indices[chess_engine_rand(eng) % (uint32_t)best_count];
     *out = list.moves[idx];
     return 1;
 }
@@ -1,86 +1,161 @@
 /**
  * @file chess_ai_medium.c
  * @brief Medium AI：Negamax + Alpha-Beta，3 层搜索，叶子用 eval_material（demo 为 2 层，此处加深以增强棋力）
+ *
+ * 搜索本体在 chess_search.c（共享置换表）；本文件用 MultiPV 根搜索取前几名的精确分，
+ * 在最佳分 CHESS_MEDIUM_MARGIN_CP 以内按分差加权随机选步；其余根着法只做零窗口检验。
+ * 对方回合的后台思考按预测着法先把下一回合的 MultiPV 算好；本步搜索与后台思考都可按微秒预算分片续算。
+ * 本步的 MultiPV 与后台思考状态分别在 eng->mp、eng->ponder。
  */
 
-#include <stdlib.h>
+#include <stddef.h>
 #include "chess_state.h"
 #include "chess_move.h"
 #include "chess_result.h"
-#include "chess_eval.h"
 #include "chess_legal.h"
+#include "chess_search.h"
+#include "chess_tt.h"
+#include "chess_zobrist.h"
+#include "chess_engine.h"
 #include "chess_ai.h"
+#include "game_clock.h"
 
-#if defined(PICO_ON_DEVICE) && defined(LIB_PICO_STDLIB)
-#include "pico/stdlib.h"
-#include "pico/time.h"
+#define CHESS_MEDIUM_SEARCH_DEPTH 3   /* 3 层：己方-对方-己方 再评估，比 2 层强不少；再高在 Pico 上会变慢 */
+
+/* 保留精确分的着法数，以及可随机选取的范围（低于最佳不超过此厘兵数） */
+#ifndef CHESS_MEDIUM_MULTIPV
+#define CHESS_MEDIUM_MULTIPV 4
+#endif
+#ifndef CHESS_MEDIUM_MARGIN_CP
+#define CHESS_MEDIUM_MARGIN_CP 50
 #endif
 
-#define CHESS_MATE_SCORE 10000
-#define CHESS_MEDIUM_SEARCH_DEPTH 3   /* 3 层：己方-对方-己方 再评估，比 2 层强不少；再高在 Pico 上会变慢 */
+/* 后台思考每片时长：片间检查一次按键 */
+#define CHESS_MEDIUM_PONDER_STEP_US 1000u
+
+static void medium_limits(ChessSearchLimits *l) {
+    chess_search_limits_init(l);
+    l->no_quiesce = 1;
+}
 
-/** Negamax + Alpha-Beta：返回当前行棋方的得分，越大越有利 */
-static int search(const ChessBoardState *state, int depth, int alpha, int beta) {
+/* 打乱走法顺序后初始化 MultiPV：排序是稳定的，同分着法的先后即随机，前 k 名不总是同几步 */
+static void medium_multipv_init(ChessEngine *eng, ChessMultiPv *mp, const ChessBoardState *pos) {
     ChessAllMovesList list;
-    chess_all_legal_moves(state, &list);
+    chess_all_legal_moves(pos, &list);
+    for (int i = list.count - 1; i > 0; i--) {
+        int j = (int)(chess_engine_rand(eng) % (uint32_t)(i + 1));
+        ChessMove t = list.moves[i];
+        list.moves[i] = list.moves[j];
+        list.moves[j] = t;
+    }
+    chess_multipv_init(eng, mp, pos, &list, CHESS_MEDIUM_SEARCH_DEPTH, CHESS_MEDIUM_MULTIPV, CHESS_MEDIUM_MARGIN_CP);
+}
 
-    if (list.count == 0) {
-        int result = chess_get_game_result(state);
-        if (result == 3) return 0;
-        int current_side_won = (result == 1 && state->side_to_move == 1) || (result == 2 && state->side_to_move == 0);
-        return current_side_won ? CHESS_MATE_SCORE : -CHESS_MATE_SCORE;
+/* 分差加权：权重 margin + 1 - (最佳 - 分)，最佳着法权重最大，边缘着法接近 1 */
+static const ChessMove *medium_pick(ChessEngine *eng, const ChessMultiPv *mp) {
+    int weights[CHESS_MULTIPV_MAX];
+    int total = 0;
+    for (int i = 0; i < mp->count; i++) {
+        int w = mp->margin + 1 - (mp->top[0].score - mp->top[i].score);
+        weights[i] = (w > 0) ? w : 0;
+        total += weights[i];
+    }
+    if (total <= 0) return &mp->top[0].move;
+    int r = (int)(chess_engine_rand(eng) % (uint32_t)total);
+    for (int i = 0; i < mp->count; i++) {
+        if (r < weights[i]) return &mp->top[i].move;
+        r -= weights[i];
     }
+    return &mp->top[0].move;
+}
 
-    if (depth == 0)
-        return chess_eval_material(state, state->side_to_move);
+/* 本步 MultiPV：命中预测时接着后台思考的进度算剩余根走法；无合法步返回 0 */
+int chess_ai_medium_begin(ChessEngine *eng, const ChessBoardState *state) {
+    ChessMultiPv *mp = &eng->mp;
+    ChessPonder *ponder = &eng->ponder;
+    if (ponder->active && !ponder->predicting && chess_state_equal(&ponder->pos, state))
+        *mp = ponder->mp;
+    else
+        medium_multipv_init(eng, mp, state);
+    ponder->active = 0;
+    eng->last_stats.depth = CHESS_MEDIUM_SEARCH_DEPTH;  /* 后台思考全部命中时本步不再搜索 */
+    return mp->list.count > 0;
+}
 
-    int best = -CHESS_MATE_SCORE - 1;
-    for (int i = 0; i < list.count; i++) {
-        ChessBoardState next = *state;
-        chess_do_move(&next, &list.moves[i]);
-        int score = -search(&next, depth - 1, -beta, -alpha);
-        if (score > best) best = score;
-        if (score > alpha) alpha = score;
-        if (alpha >= beta) break;
+/* 续算本步 MultiPV 至多 budget_us（0 = 算完）；算完时选出着法写入 *out 并返回 1 */
+int chess_ai_medium_step(ChessEngine *eng, const ChessBoardState *state, uint32_t budget_us,
+                         ChessMove *out, ChessSearchStats *stats) {
+    ChessSearchLimits limits;
+    medium_limits(&limits);
+    limits.stats = stats;
+    if (!chess_multipv_step(eng, &eng->mp, state, &limits, budget_us)) return 0;
+    *out = *medium_pick(eng, &eng->mp);
+    return 1;
+}
+
+/* 以对方着法 reply 建立预测局面 */
+static void ponder_set_reply(ChessEngine *eng, const ChessMove *reply) {
+    ChessPonder *ponder = &eng->ponder;
+    ponder->pos = ponder->human_pos;
+    chess_do_move(&ponder->pos, reply);
+    medium_multipv_init(eng, &ponder->mp, &ponder->pos);
+    ponder->predicting = 0;
+    ponder->active = ponder->mp.list.count > 0;
+}
+
+void chess_ai_medium_ponder_start(ChessEngine *eng, const ChessBoardState *state) {
+    ChessPonder *ponder = &eng->ponder;
+    ponder->active = 1;
+    ponder->predicting = 1;
+    ponder->human_pos = *state;
+    /* 预测着法：上一步搜索已把对方局面的最佳应着存入置换表（即 PV 第二步）；被覆盖时再补搜 */
+    ChessTTEntry tt;
+    if (!chess_tt_probe(&eng->tt, chess_zobrist_hash(state), &tt)) return;
+    ChessAllMovesList replies;
+    chess_all_legal_moves(state, &replies);
+    for (int i = 0; i < replies.count; i++) {
+        if (chess_tt_move_is(&tt, &replies.moves[i])) {
+            ponder_set_reply(eng, &replies.moves[i]);
+            return;
+        }
     }
-    return best;
 }
 
-int chess_ai_pick_move_medium(const ChessBoardState *state, ChessMove *out) {
-    ChessAllMovesList list;
-    chess_all_legal_moves(state, &list);
-    if (list.count == 0) return 0;
+int chess_ai_medium_ponder_slice(ChessEngine *eng, uint32_t budget_ms, int (*poll)(void *user), void *user) {
+    ChessPonder *ponder = &eng->ponder;
+    if (!ponder->active) return 1;
 
-    int best_score = -CHESS_MATE_SCORE - 1;
-    int best_count = 0;
-    int best_indices[CHESS_ALL_MOVES_MAX];
-    const int alpha0 = -CHESS_MATE_SCORE - 1;
-    int beta = CHESS_MATE_SCORE + 1;
+    ChessSearchLimits limits;
+    medium_limits(&limits);
+    limits.poll = poll;
+    limits.poll_user = user;
+    limits.poll_nodes = 1;
+    uint64_t deadline = game_clock_us() + (uint64_t)budget_ms * 1000u;
+    limits.movetime_ms = budget_ms;
 
-    for (int i = 0; i < list.count; i++) {
-        ChessBoardState next = *state;
-        chess_do_move(&next, &list.moves[i]);
-        int score = -search(&next, CHESS_MEDIUM_SEARCH_DEPTH - 1, -beta, -alpha0);
-        if (score > best_score) {
-            best_score = score;
-            best_count = 0;
-            best_indices[best_count++] = i;
-        } else if (score == best_score) {
-            best_indices[best_count++] = i;
+    if (ponder->predicting) {
+        ChessSearchResult res;
+        limits.depth = CHESS_MEDIUM_SEARCH_DEPTH - 1;
+        if (!chess_search_run(eng, &ponder->human_pos, &limits, &res)) {
+            ponder->active = 0;
+            return 1;
         }
+        if (res.info.depth < limits.depth) return 0;
+        ponder_set_reply(eng, &res.best);
+        if (!ponder->active) return 1;
+        limits.depth = 0;
     }
 
-    int idx = (best_count > 0) ? best_indices[0] : 0;
-    if (best_count > 1) {
-#if defined(PICO_ON_DEVICE) && defined(LIB_PICO_STDLIB)
-        static int seeded = 0;
-        if (!seeded) {
-            srand((unsigned)(to_us_since_boot(get_absolute_time()) & 0x7FFF));
-            seeded = 1;
-        }
-#endif
-        idx = best_indices[rand() % best_count];
+    /* 按约 1ms 一片续算，片间调用 poll；被打断时帧栈原样保留，下次接着算 */
+    limits.movetime_ms = 0;
+    limits.poll = NULL;
+    for (;;) {
+        uint64_t now = game_clock_us();
+        if (now >= deadline) return 0;
+        uint64_t left = deadline - now;
+        if (chess_multipv_step(eng, &ponder->mp, &ponder->pos, &limits,
+                               (uint32_t)(left < CHESS_MEDIUM_PONDER_STEP_US ? left : CHESS_MEDIUM_PONDER_STEP_US)))
+            return 1;
+        if (poll && poll(user)) return 0;
     }
-    *out = list.moves[idx];
-    return 1;
 }
@@ -0,0 +1,143 @@
+/**
+ * @file chess_analysis.c
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "chess_state.h"
+#include "chess_move.h"
+#include "chess_legal.h"
+#include "chess_check.h"
+#include "chess_notation.h"
+#include "chess_search.h"
+#include "chess_record.h"
+#include "chess_engine.h"
+#include "chess_analysis.h"
+#include "game_clock.h"
+
+void chess_analysis_begin(ChessAnalysis *an, const ChessGameRecord *rec) {
+    an->count = rec->count;
+    an->next = rec->count;
+    an->aborted = 0;
+    chess_search_stats_clear(&an->stats);
+}
+
+int chess_analysis_step(ChessEngine *eng, ChessAnalysis *an, const ChessGameRecord *rec,
+                        const ChessSearchLimits *limits) {
+    if (an->next < 0 || an->aborted) return 1;
+    int i = an->next;
+    ChessBoardState pos;
+    if (!chess_record_position(rec, i, &pos)) {
+        an->aborted = 1;
+        return 1;
+    }
+    ChessSearchLimits l = *limits;
+    l.stats = &an->stats;
+    ChessSearchResult res;
+    uint32_t elapsed = an->stats.elapsed_us;
+    uint64_t t0 = game_clock_us();
+    if (!chess_search_run(eng, &pos, &l, &res)) {
+        /* 终局面：被将死或逼和 */
+        an->score[i] = (int16_t)(chess_is_king_in_check(&pos, pos.side_to_move) ? -CHESS_SEARCH_MATE : 0);
+        an->depth[i] = 0;
+    } else if (eng->abort || res.info.depth == 0) {
+        an->aborted = 1;
+    } else {
+        an->score[i] = (int16_t)res.info.score;
+        an->depth[i] = (uint8_t)res.info.depth;
+        an->best[i].from_sq = (uint8_t)(res.best.from_r * 8 + res.best.from_c);
+        an->best[i].to_sq = (uint8_t)(res.best.to_r * 8 + res.best.to_c);
+    }
+    /* 节点等按搜索统计累计，时间按墙钟（含回放局面） */
+    an->stats.elapsed_us = elapsed + (uint32_t)(game_clock_us() - t0);
+    chess_search_stats_finish(&an->stats);
+    if (an->aborted) return 1;
+    an->next--;
+    return an->next < 0;
+}
+
+void chess_analyze_game(ChessEngine *eng, ChessAnalysis *an, const ChessGameRecord *rec,
+                        const ChessSearchLimits *limits) {
+    chess_analysis_begin(an, rec);
+    while (!chess_analysis_step(eng, an, rec, limits)) {}
+}
+
+int chess_analysis_has_ply(const ChessAnalysis *an, int ply) {
+    return ply > an->next && ply < an->count;
+}
+
+int chess_analysis_loss(const ChessAnalysis *an, const ChessGameRecord *rec, int ply) {
+    const ChessGameMove *played = &rec->moves[ply];
+    if (played->from_sq == an->best[ply].from_sq && played->to_sq == an->best[ply].to_sq) return 0;
+    int loss = an->score[ply] + an->score[ply + 1];   /* 最佳分 - (-对方着后分) */
+    return loss > 0 ? loss : 0;
+}
+
+int chess_analysis_grade(int loss) {
+    if (loss >= CHESS_ANALYSIS_BLUNDER_CP) return CHESS_ANALYSIS_BLUNDER;
+    if (loss >= CHESS_ANALYSIS_MISTAKE_CP) return CHESS_ANALYSIS_MISTAKE;
+    if (loss >= CHESS_ANALYSIS_INACCURACY_CP) return CHESS_ANALYSIS_INACCURACY;
+    return CHESS_ANALYSIS_GOOD;
+}
+
+void chess_analysis_count(const ChessAnalysis *an, const ChessGameRecord *rec, int color,
+                          int counts[CHESS_ANALYSIS_GRADES]) {
+    memset(counts, 0, CHESS_ANALYSIS_GRADES * sizeof(int));
+    for (int i = 0; i < an->count; i++)
+        if (chess_analysis_has_ply(an, i) && chess_record_side(rec, i) == color)
+            counts[chess_analysis_grade(chess_analysis_loss(an, rec, i))]++;
+}
+
+static const char *const s_grade_mark[CHESS_ANALYSIS_GRADES] = { "", " ?!", " ?", " ??" };
+
+/* 行棋方视角的分换成白方视角；杀棋写作 #N（N 为步数，负号表示黑方杀），已被将死的终局写作 1-0 / 0-1 */
+static void format_score(char *buf, int size, int score, int side) {
+    int white = side ? score : -score;
+    if (white == CHESS_SEARCH_MATE || white == -CHESS_SEARCH_MATE)
+        snprintf(buf, (size_t)size, "%s", white > 0 ? "1-0" : "0-1");
+    else if (white > CHESS_SEARCH_MATE_BOUND)
+        snprintf(buf, (size_t)size, "#%d", (CHESS_SEARCH_MATE - white + 1) / 2);
+    else if (white < -CHESS_SEARCH_MATE_BOUND)
+        snprintf(buf, (size_t)size, "#-%d", (CHESS_SEARCH_MATE + white + 1) / 2);
+    else
+        snprintf(buf, (size_t)size, "%d", white);
+}
+
+void chess_analysis_print(const ChessAnalysis *an, const ChessGameRecord *rec) {
+    ChessBoardState pos;
+    if (!chess_record_position(rec, 0, &pos)) return;
+    int first_white = chess_record_side(rec, 0);
+    for (int i = 0; i < an->count; i++) {
+        ChessMove m;
+        chess_record_expand(&pos, &rec->moves[i], &m);
+        if (chess_analysis_has_ply(an, i)) {
+            char san[CHESS_SAN_MAX], best[CHESS_SAN_MAX], before[12], after[12];
+            int side = pos.side_to_move;
+            int loss = chess_analysis_loss(an, rec, i);
+            chess_move_to_san(&pos, &m, san);
+            format_score(before, sizeof(before), an->score[i], side);
+            format_score(after, sizeof(after), an->score[i + 1], 1 - side);
+            printf("analysis %d%s %s eval %s %s loss %d", (i + !first_white) / 2 + 1, side ? "." : "...", san,
+                   before, after, loss);
+            if (loss > 0) {
+                ChessMove bm;
+                chess_record_expand(&pos, &an->best[i], &bm);
+                chess_move_to_san(&pos, &bm, best);
+                printf(" best %s", best);
+            }
+            printf("%s depth %d\n", s_grade_mark[chess_analysis_grade(loss)], an->depth[i]);
+        }
+        chess_do_move(&pos, &m);
+    }
+    int done = an->count - an->next - 1;
+    int w[CHESS_ANALYSIS_GRADES], b[CHESS_ANALYSIS_GRADES];
+    chess_analysis_count(an, rec, 1, w);
+    chess_analysis_count(an, rec, 0, b);
+    printf("analysis summary plies %d%s time %lu ms nodes %lu nps %lu white ?! %d ? %d ?? %d black ?! %d ? %d ?? %d\n",
+           done > 0 ? done : 0,
+           an->aborted ? " (aborted)" : "", (unsigned long)(an->stats.elapsed_us / 1000u),
+           (unsigned long)an->stats.nodes, (unsigned long)an->stats.nps,
+           w[CHESS_ANALYSIS_INACCURACY], w[CHESS_ANALYSIS_MISTAKE], w[CHESS_ANALYSIS_BLUNDER],
+           b[CHESS_ANALYSIS_INACCURACY], b[CHESS_ANALYSIS_MISTAKE], b[CHESS_ANALYSIS_BLUNDER]);
+    fflush(stdout);
+}
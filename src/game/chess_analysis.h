@@ -0,0 +1,72 @@
+/**
+ * @file chess_analysis.h
+ * @brief 赛后分析：从最后一个局面倒着搜到第一个，全程共用引擎的置换表，给出每步的评估变化与损失
+ *
+ * 倒序的好处：后面的局面正是前面局面搜索树里的节点，先搜后段，前段搜索时就能直接命中置换表里已算好的子树，
+ * 同样的预算下搜得更深。每步的损失 = 着前局面最佳分 - 实际着法之后的分（同一方视角，不为负），
+ * 按 CHESS_ANALYSIS_*_CP 分为缓着 ?!、错着 ?、败着 ??。
+ * 可一次做完（chess_analyze_game），也可逐个局面调用 chess_analysis_step 与界面交替。
+ */
+
+#ifndef PICO_CODE_CHESS_ANALYSIS_H
+#define PICO_CODE_CHESS_ANALYSIS_H
+
+#include <stdint.h>
+#include "chess_search.h"
+#include "chess_record.h"
+
+#define CHESS_ANALYSIS_INACCURACY_CP 50
+#define CHESS_ANALYSIS_MISTAKE_CP    100
+#define CHESS_ANALYSIS_BLUNDER_CP    300
+
+enum {
+    CHESS_ANALYSIS_GOOD = 0,
+    CHESS_ANALYSIS_INACCURACY,
+    CHESS_ANALYSIS_MISTAKE,
+    CHESS_ANALYSIS_BLUNDER,
+    CHESS_ANALYSIS_GRADES
+};
+
+typedef struct {
+    int16_t score[CHESS_GAME_MAX_PLIES + 1];    /* 第 i 步走子前局面的分（行棋方视角，厘兵） */
+    ChessGameMove best[CHESS_GAME_MAX_PLIES];   /* 该局面搜出的最佳着法 */
+    uint8_t depth[CHESS_GAME_MAX_PLIES + 1];    /* 完成的深度（终局面为 0） */
+    int count;                                  /* 着法数（= 记录的 count） */
+    int next;                                   /* 下一个要搜的局面，倒序递减；< 0 为全部完成 */
+    int aborted;                                /* 被中止：只有 next 之后的局面有结果 */
+    ChessSearchStats stats;                     /* 全部局面合计，elapsed_us 为总分析时间 */
+} ChessAnalysis;
+
+void chess_analysis_begin(ChessAnalysis *an, const ChessGameRecord *rec);
+
+/**
+ * 搜下一个局面（倒序），每个局面按 limits 独立计时/限深；limits->stats 不使用。
+ * 全部完成或被中止（eng->abort、或一层都没搜完）返回 1。
+ */
+int chess_analysis_step(ChessEngine *eng, ChessAnalysis *an, const ChessGameRecord *rec,
+                        const ChessSearchLimits *limits);
+
+/** 一次分析整局 */
+void chess_analyze_game(ChessEngine *eng, ChessAnalysis *an, const ChessGameRecord *rec,
+                        const ChessSearchLimits *limits);
+
+/** 第 ply 步是否已有结果（着前与着后局面都已搜过） */
+int chess_analysis_has_ply(const ChessAnalysis *an, int ply);
+
+/** 第 ply 步的损失（厘兵，≥ 0；走的就是最佳着法时为 0） */
+int chess_analysis_loss(const ChessAnalysis *an, const ChessGameRecord *rec, int ply);
+
+/** 损失对应的等级 CHESS_ANALYSIS_GOOD..BLUNDER */
+int chess_analysis_grade(int loss);
+
+/** 统计 color 方（0=黑 1=白）已分析着法的各等级数 */
+void chess_analysis_count(const ChessAnalysis *an, const ChessGameRecord *rec, int color,
+                          int counts[CHESS_ANALYSIS_GRADES]);
+
+/**
+ * 逐步打印 "analysis 12. Nf3 eval 35 -120 loss 155 best d4 ?? depth 5"（评估为白方视角，杀棋写作 #N / #-N，将死的终局写作 1-0 / 0-1），
+ * 最后一行 "analysis summary plies … time … ms nodes … white ?! a ? b ?? c black …"
+ */
+void chess_analysis_print(const ChessAnalysis *an, const ChessGameRecord *rec);
+
+#endif /* PICO_CODE_CHESS_ANALYSIS_H */
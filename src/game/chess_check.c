@@ -9,11 +9,11 @@
 #include "chess_check.h"
 
 int chess_find_king(const int8_t board[8][8], int side, int *out_r, int *out_c) {
-    int8_t king_idx = (side == 0) ? 1 : 7;
+    int8_t king = CHESS_PIECE(side, CHESS_PIECE_KING);
     *out_r = *out_c = -1;
     for (int r = 0; r < 8; r++) {
         for (int c = 0; c < 8; c++) {
-            if (board[r][c] == king_idx) {
+            if (board[r][c] == king) {
                 *out_r = r;
                 *out_c = c;
                 return 1;
@@ -0,0 +1,33 @@
+/**
+ * @file chess_engine.c
+ */
+
+#include <string.h>
+#include "chess_tt.h"
+#include "chess_zobrist.h"
+#include "chess_engine.h"
+
+#define ENGINE_DEFAULT_SEED 0x2545F491u
+
+void chess_engine_init(ChessEngine *eng, uint32_t seed) {
+    chess_zobrist_init();
+    memset(eng, 0, sizeof(*eng));
+    eng->rng = seed ? seed : ENGINE_DEFAULT_SEED;
+}
+
+void chess_engine_new_game(ChessEngine *eng) {
+    chess_tt_clear(&eng->tt);
+    memset(eng->killers, 0, sizeof(eng->killers));
+    memset(eng->history, 0, sizeof(eng->history));
+    eng->ponder.active = 0;
+    eng->abort = 0;
+}
+
+uint32_t chess_engine_rand(ChessEngine *eng) {
+    uint32_t x = eng->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    eng->rng = x;
+    return x;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file chess_engine.h
+ * @brief 引擎上下文：随机数、置换表、杀棋表、杀手/历史表、搜索工作区、统计、中止标志与后台思考状态
+ *
+ * 搜索与 AI 的可变状态全部在 ChessEngine 里，没有文件级静态变量：每个核/线程各用一个引擎即可同时搜索，
+ * 同一个引擎同一时刻只能有一个搜索。结构较大（默认配置约 72KB），放静态区或堆上（chess_ui 在进入国际象棋时 malloc），不要放栈上。
+ * Zobrist 键表是全局只读的，由 chess_engine_init 生成，多线程前先初始化一个引擎；
+ * 搜索跟踪（chess_trace.h）是全局调试缓冲，只在单线程下有意义。
+ */
+
+#ifndef PICO_CODE_CHESS_ENGINE_H
+#define PICO_CODE_CHESS_ENGINE_H
+
+#include <stdint.h>
+#include "chess_types.h"
+#include "chess_state.h"
+#include "chess_move.h"
+#include "chess_search.h"
+#include "chess_tt.h"
+#include "chess_mate.h"
+
+/** Medium 后台思考状态：预测局面（轮到 AI）及其未完成的 MultiPV */
+typedef struct {
+    int active;
+    int predicting;             /* 置换表里没有预测着法，先在对方局面上搜出 PV */
+    ChessBoardState human_pos;
+    ChessBoardState pos;
+    ChessMultiPv mp;
+} ChessPonder;
+
+/** 分片选步任务（chess_ai_begin / chess_ai_step） */
+typedef struct {
+    int phase;
+    int difficulty;             /* ChessAiDifficulty */
+    ChessBoardState state;
+    ChessMateJob mate;          /* Medium 正式搜索前的找杀 */
+    uint32_t elapsed_us;        /* 各片耗时之和（不含片间界面时间） */
+    int has_move;
+    ChessMove move;
+} ChessAiJob;
+
+struct ChessEngine {
+    uint32_t rng;                                   /* xorshift32 状态（非 0） */
+    volatile int abort;                             /* 置 1 后搜索尽快返回，可由另一核/线程置位；新对局与 AI 选步、后台思考开始时清零，其余发起方在开始前自行清零 */
+    ChessTT tt;
+    ChessMateTT mate_tt;
+    ChessMove killers[CHESS_SEARCH_MAX_PLY][2];     /* 每层最近两个产生剪枝的安静着法 */
+    uint16_t history[CHESS_PIECE_CODES][64];        /* 安静着法剪枝计分：[棋子][目标格] */
+    ChessSearchWork work;
+    ChessSearchStats last_stats;                    /* 最近一次选步（整步合计） */
+    ChessMultiPv mp;                                /* Medium 本步的根搜索 */
+    ChessPonder ponder;
+    ChessAiJob job;
+};
+
+/** 初始化（含清空各表）；seed 为 0 时用固定种子 */
+void chess_engine_init(ChessEngine *eng, uint32_t seed);
+
+/** 新对局：清空置换表、杀手/历史表、后台思考状态与中止标志（随机数流不重置） */
+void chess_engine_new_game(ChessEngine *eng);
+
+/** 引擎自己的随机数流（xorshift32），不使用全局 rand() */
+uint32_t chess_engine_rand(ChessEngine *eng);
+
+#endif /* PICO_CODE_CHESS_ENGINE_H */
@@ -0,0 +1,222 @@
+/**
+ * @file chess_epd.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "chess_state.h"
+#include "chess_move.h"
+#include "chess_notation.h"
+#include "chess_search.h"
+#include "chess_mate.h"
+#include "chess_engine.h"
+#include "chess_epd.h"
+
+static const char *skip_ws(const char *s) {
+    while (*s == ' ' || *s == '\t') s++;
+    return s;
+}
+
+static int word_len(const char *s) {
+    int n = 0;
+    while (s[n] && s[n] != ' ' && s[n] != '\t' && s[n] != ';' && s[n] != '\r' && s[n] != '\n') n++;
+    return n;
+}
+
+/* 解析 "bm Nf3 Ng5" 一类操作数：逐个 SAN 匹配合法走法，直到分号 */
+static const char *parse_moves(const ChessBoardState *b, const char *s, ChessMove *moves, int *count) {
+    for (s = skip_ws(s); *s && *s != ';'; s = skip_ws(s)) {
+        int n = word_len(s);
+        if (n == 0) { s++; continue; }
+        ChessMove m;
+        if (*count < CHESS_EPD_MAX_MOVES && chess_move_from_san(b, s, &m))
+            moves[(*count)++] = m;
+        s += n;
+    }
+    return s;
+}
+
+int chess_epd_parse(const char *line, ChessEpdEntry *out) {
+    const char *s = skip_ws(line);
+    if (*s == '\0' || *s == '#' || *s == '\r' || *s == '\n') return 0;
+    if (!chess_state_from_fen(&out->state, s, &s)) return 0;
+    out->bm_count = 0;
+    out->am_count = 0;
+    out->dm = 0;
+    out->id[0] = '\0';
+
+    /* 部分文件在四段之后仍带半回合/回合计数 */
+    for (int k = 0; k < 2; k++) {
+        s = skip_ws(s);
+        if (*s < '0' || *s > '9') break;
+        s += word_len(s);
+    }
+
+    while (*(s = skip_ws(s))) {
+        int n = word_len(s);
+        if (n == 0) { s++; continue; }
+        const char *op = s;
+        s += n;
+        if (n == 2 && strncmp(op, "bm", 2) == 0) {
+            s = parse_moves(&out->state, s, out->bm, &out->bm_count);
+        } else if (n == 2 && strncmp(op, "am", 2) == 0) {
+            s = parse_moves(&out->state, s, out->am, &out->am_count);
+        } else if (n == 2 && strncmp(op, "dm", 2) == 0) {
+            out->dm = atoi(skip_ws(s));
+        } else if (n == 2 && strncmp(op, "id", 2) == 0) {
+            s = skip_ws(s);
+            int quoted = (*s == '"');
+            if (quoted) s++;
+            int len = 0;
+            while (*s && *s != (quoted ? '"' : ';') && *s != '\r' && *s != '\n') {
+                if (len < CHESS_EPD_ID_MAX - 1) out->id[len++] = *s;
+                s++;
+            }
+            out->id[len] = '\0';
+            if (quoted && *s == '"') s++;
+        }
+        /* 其余操作（c0、hmvc 等）跳到分号 */
+        while (*s && *s != ';') s++;
+        if (*s == ';') s++;
+    }
+    return 1;
+}
+
+static int in_moves(const ChessMove *m, const ChessMove *moves, int count) {
+    for (int i = 0; i < count; i++)
+        if (chess_move_equal(m, &moves[i])) return 1;
+    return 0;
+}
+
+static int is_solution(const ChessEpdEntry *e, const ChessMove *m) {
+    if (in_moves(m, e->am, e->am_count)) return 0;
+    return e->bm_count == 0 || in_moves(m, e->bm, e->bm_count);
+}
+
+typedef struct {
+    const ChessEpdEntry *entry;
+    ChessEpdOutcome *out;
+    int was_solved;
+} EpdTracker;
+
+/* 每层迭代：最佳着法变为正确时记下时刻，变错则清零，得到"最后一次解出"的时间 */
+static void track_info(const ChessSearchInfo *info, void *user) {
+    EpdTracker *t = (EpdTracker *)user;
+    if (info->pv_len == 0) return;
+    int ok = is_solution(t->entry, &info->pv[0]);
+    if (ok && !t->was_solved) {
+        t->out->solve_ms = info->elapsed_ms;
+        t->out->solve_nodes = info->nodes;
+    } else if (!ok) {
+        t->out->solve_ms = 0;
+        t->out->solve_nodes = 0;
+    }
+    t->was_solved = ok;
+}
+
+/* 解题模式：杀棋求解，找到且符合 bm/dm 即解出 */
+static void run_mate(ChessEngine *eng, const ChessEpdEntry *e, const ChessSearchLimits *limits, int mate_moves,
+                     ChessEpdOutcome *out) {
+    ChessSearchLimits l = *limits;
+    l.depth = mate_moves;
+    l.stats = NULL;
+    ChessMateResult res;
+    if (chess_mate_search(eng, &e->state, &l, &res)) {
+        out->has_move = 1;
+        out->best = res.best;
+        out->mate_in = res.mate_in;
+        out->solved = is_solution(e, &res.best) && (e->dm == 0 || res.mate_in <= e->dm);
+    }
+    out->stats = res.stats;
+    if (out->solved) {
+        out->solve_ms = res.stats.elapsed_us / 1000u;
+        out->solve_nodes = res.stats.nodes;
+    }
+}
+
+void chess_epd_run(ChessEngine *eng, const ChessEpdEntry *e, const ChessSearchLimits *limits, int mate_moves,
+                   ChessEpdOutcome *out) {
+    memset(out, 0, sizeof(*out));
+    if (mate_moves > 0) {
+        run_mate(eng, e, limits, mate_moves, out);
+        return;
+    }
+    EpdTracker tracker = { e, out, 0 };
+    ChessSearchLimits l = *limits;
+    l.on_info = track_info;
+    l.info_user = &tracker;
+    l.stats = NULL;
+
+    chess_engine_new_game(eng);
+    ChessSearchResult res;
+    if (chess_search_run(eng, &e->state, &l, &res)) {
+        out->has_move = 1;
+        out->best = res.best;
+        out->solved = is_solution(e, &res.best);
+    }
+    out->stats = res.stats;
+    if (!out->solved) {
+        out->solve_ms = 0;
+        out->solve_nodes = 0;
+    } else if (!tracker.was_solved) {
+        /* 最后一层被中止时才换到正确着法：以整次搜索计 */
+        out->solve_ms = res.stats.elapsed_us / 1000u;
+        out->solve_nodes = res.stats.nodes;
+    }
+}
+
+void chess_epd_summary_clear(ChessEpdSummary *sum) {
+    memset(sum, 0, sizeof(*sum));
+}
+
+int chess_epd_run_line(ChessEngine *eng, const char *line, const ChessSearchLimits *limits, int mate_moves,
+                       ChessEpdSummary *sum) {
+    ChessEpdEntry e;
+    const char *s = skip_ws(line);
+    if (*s == '\0' || *s == '#' || *s == '\r' || *s == '\n') return 0;
+    if (!chess_epd_parse(s, &e) || (e.bm_count == 0 && e.am_count == 0 && !(mate_moves > 0 && e.dm > 0))) {
+        int n = 0;
+        while (s[n] && s[n] != '\r' && s[n] != '\n' && n < 40) n++;
+        printf("epd skip %.*s\n", n, s);
+        sum->skipped++;
+        return 0;
+    }
+    if (e.id[0] == '\0') snprintf(e.id, sizeof(e.id), "#%d", sum->positions + sum->skipped + 1);
+
+    ChessEpdOutcome o;
+    chess_epd_run(eng, &e, limits, mate_moves, &o);
+    sum->positions++;
+    sum->solved += o.solved;
+    sum->nodes += o.stats.nodes;
+    sum->elapsed_us += o.stats.elapsed_us;
+    if (o.solved) sum->solve_ms += o.solve_ms;
+
+    char best[CHESS_SAN_MAX] = "-";
+    char want[CHESS_SAN_MAX];
+    if (o.has_move) chess_move_to_san(&e.state, &o.best, best);
+    printf("epd %s %s best %s", e.id, o.solved ? "solved" : "failed", best);
+    if (o.mate_in) printf(" mate %d", o.mate_in);
+    if (e.bm_count || e.am_count) printf(" %s", e.bm_count ? "bm" : "am");
+    for (int i = 0; i < (e.bm_count ? e.bm_count : e.am_count); i++) {
+        chess_move_to_san(&e.state, e.bm_count ? &e.bm[i] : &e.am[i], want);
+        printf(" %s", want);
+    }
+    if (e.dm) printf(" dm %d", e.dm);
+    if (o.solved)
+        printf(" solve-time %lu solve-nodes %lu", (unsigned long)o.solve_ms, (unsigned long)o.solve_nodes);
+    printf(" depth %d time %lu nodes %lu\n", o.stats.depth,
+           (unsigned long)(o.stats.elapsed_us / 1000), (unsigned long)o.stats.nodes);
+    fflush(stdout);
+    return 1;
+}
+
+void chess_epd_print_summary(const ChessEpdSummary *sum) {
+    unsigned long nps = sum->elapsed_us ? (unsigned long)(sum->nodes * 1000000ull / sum->elapsed_us) : 0;
+    printf("epd summary solved %d/%d (%.1f%%) skipped %d nodes %llu time %lu ms nps %lu avg-solve %lu ms\n",
+           sum->solved, sum->positions,
+           sum->positions ? 100.0 * sum->solved / sum->positions : 0.0,
+           sum->skipped, (unsigned long long)sum->nodes, (unsigned long)(sum->elapsed_us / 1000), nps,
+           sum->solved ? (unsigned long)(sum->solve_ms / (uint64_t)sum->solved) : 0ul);
+    fflush(stdout);
+}
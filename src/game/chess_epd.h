@@ -0,0 +1,73 @@
+/**
+ * @file chess_epd.h
+ * @brief EPD 测试集运行：解析 "FEN四段 bm Nf3; am ...; id ..." 行，在固定深度/节点/时间预算下搜索，
+ *        记录解出时间（最佳着法最后一次变为 bm 之一时的耗时与节点数），并汇总解出率与 nps
+ *
+ * mate_moves > 0 时为解题模式：改用杀棋求解（chess_mate.h），要求在 mate_moves 步内找到杀，
+ * 且着法在 bm 中（如有）、步数不超过 dm（如有）。
+ *
+ * 主机工具 chess_epd 与 UCI 的 epd 命令（经 USB 串口）共用这里的代码，输出格式一致。
+ */
+
+#ifndef PICO_CODE_CHESS_EPD_H
+#define PICO_CODE_CHESS_EPD_H
+
+#include <stdint.h>
+#include "chess_state.h"
+#include "chess_move.h"
+#include "chess_search.h"
+
+#define CHESS_EPD_MAX_MOVES 4
+#define CHESS_EPD_ID_MAX    32
+
+typedef struct {
+    ChessBoardState state;
+    ChessMove bm[CHESS_EPD_MAX_MOVES];  /* best move：搜到其中之一即算解出 */
+    int bm_count;
+    ChessMove am[CHESS_EPD_MAX_MOVES];  /* avoid move：搜到其中之一即算失败 */
+    int am_count;
+    int dm;                             /* direct mate：N 步杀（0 = 未给出） */
+    char id[CHESS_EPD_ID_MAX];
+} ChessEpdEntry;
+
+/** 单个局面的结果 */
+typedef struct {
+    int solved;
+    int has_move;               /* 0 = 局面无合法走法 */
+    ChessMove best;
+    uint32_t solve_ms;          /* 解出时间（未解出为 0） */
+    uint32_t solve_nodes;
+    int mate_in;                /* 解题模式找到的杀步数（0 = 未找到） */
+    ChessSearchStats stats;     /* 整次搜索 */
+} ChessEpdOutcome;
+
+/** 全部局面合计 */
+typedef struct {
+    int positions;
+    int solved;
+    int skipped;                /* 无法解析或无 bm/am 的行 */
+    uint64_t nodes;
+    uint64_t elapsed_us;
+    uint64_t solve_ms;          /* 已解出局面的解出时间之和 */
+} ChessEpdSummary;
+
+/** 解析一行 EPD；空行/注释（#）或格式错误返回 0 */
+int chess_epd_parse(const char *line, ChessEpdEntry *out);
+
+/** 清空 eng 的置换表后按 limits 搜索 e（limits->on_info 由本函数接管）；mate_moves > 0 为解题模式 */
+void chess_epd_run(ChessEngine *eng, const ChessEpdEntry *e, const ChessSearchLimits *limits, int mate_moves,
+                   ChessEpdOutcome *out);
+
+void chess_epd_summary_clear(ChessEpdSummary *sum);
+
+/**
+ * 解析并运行一行，打印 "epd <id> solved|failed best <SAN> bm ... solve-time <ms> solve-nodes <n> depth ..." 并计入 sum。
+ * 空行与注释不计数；返回 1 表示运行了一个局面。
+ */
+int chess_epd_run_line(ChessEngine *eng, const char *line, const ChessSearchLimits *limits, int mate_moves,
+                       ChessEpdSummary *sum);
+
+/** 打印汇总行 "epd summary solved A/B (P%) ... nps N" */
+void chess_epd_print_summary(const ChessEpdSummary *sum);
+
+#endif /* PICO_CODE_CHESS_EPD_H */
@@ -8,18 +8,11 @@
 #include "chess_legal.h"
 #include "chess_eval.h"
 
-int chess_piece_value(int8_t piece_index) {
-    if (piece_index < 0) return 0;
-    ChessPieceType t = chess_piece_index_to_type(piece_index);
-    switch (t) {
-        case CHESS_PIECE_QUEEN:  return 9;
-        case CHESS_PIECE_ROOK:   return 5;
-        case CHESS_PIECE_BISHOP:
-        case CHESS_PIECE_KNIGHT: return 3;
-        case CHESS_PIECE_PAWN:   return 1;
-        case CHESS_PIECE_KING:   return 0;
-    }
-    return 0;
+/* 按类型位查表：空/兵/马/象/车/后/王/未用 */
+static const int16_t s_type_value[CHESS_PIECE_TYPE_MASK + 1] = { 0, 100, 300, 300, 500, 900, 0, 0 };
+
+int chess_piece_value(int8_t piece) {
+    return s_type_value[chess_piece_type(piece)];
 }
 
 int chess_eval_material(const ChessBoardState *b, int side) {
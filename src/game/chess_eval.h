@@ -9,8 +9,8 @@
 #include "chess_state.h"
 #include "chess_move.h"
 
-/** 子力价值（后9 车5 象马3 兵1 王0，仅用于比较） */
-int chess_piece_value(int8_t piece_index);
+/** 子力价值，单位厘兵（后900 车500 象马300 兵100 王0；UCI score cp 直接使用） */
+int chess_piece_value(int8_t piece);
 
 /** 局面评估：side 方的子力减去对方子力（越大对 side 越有利） */
 int chess_eval_material(const ChessBoardState *b, int side);
@@ -27,7 +27,7 @@ void chess_apply_move(int8_t board[8][8], const ChessMove *m) {
     if (m->is_ep) {
         board[m->from_r][m->to_c] = CHESS_EMPTY;
     }
-    board[m->to_r][m->to_c] = (m->promote_to >= 0) ? m->promote_to : piece;
+    board[m->to_r][m->to_c] = (m->promote_to != CHESS_PROMOTE_NONE) ? m->promote_to : piece;
     board[m->from_r][m->from_c] = CHESS_EMPTY;
 }
 
@@ -65,7 +65,7 @@ void chess_legal_moves_from(const ChessBoardState *b, int r, int c, ChessMoveLis
 void chess_do_move(ChessBoardState *state, const ChessMove *m) {
     int side = state->side_to_move;
     int8_t piece = state->board[m->from_r][m->from_c];
-    ChessPieceType pt = chess_piece_index_to_type(piece);
+    ChessPieceType pt = chess_piece_type(piece);
 
     if (pt == CHESS_PIECE_KING) {
         state->castling[side][0] = state->castling[side][1] = 0;
@@ -0,0 +1,338 @@
+/**
+ * @file chess_mate.c
+ */
+
+#include <string.h>
+#include "chess_state.h"
+#include "chess_move.h"
+#include "chess_legal.h"
+#include "chess_check.h"
+#include "chess_result.h"
+#include "chess_zobrist.h"
+#include "chess_search.h"
+#include "chess_mate.h"
+#include "chess_engine.h"
+#include "game_clock.h"
+
+#define NO_SQ 0xFF
+
+/* 与 chess_search.c 相同的中止检查，工作区同为 eng->work（两者不会同时运行） */
+static int check_abort(ChessEngine *eng) {
+    ChessSearchWork *w = &eng->work;
+    if (w->aborted) return 1;
+    if (w->stats.nodes < w->next_poll) return 0;
+    w->next_poll = w->stats.nodes + w->poll_nodes;
+    if (w->limits->nodes && w->stats.nodes >= w->limits->nodes) w->aborted = 1;
+    else if (w->deadline_us && game_clock_us() >= w->deadline_us) w->aborted = 1;
+    else if (eng->abort) w->aborted = 1;
+    else if (w->limits->poll && w->limits->poll(w->limits->poll_user)) w->aborted = 1;
+    return w->aborted;
+}
+
+static ChessMateTTEntry *tt_slot(ChessEngine *eng, uint64_t key) {
+    return &eng->mate_tt.entries[key & (CHESS_MATE_TT_SIZE - 1)];
+}
+
+static const ChessMateTTEntry *tt_probe(ChessEngine *eng, uint64_t key) {
+    const ChessMateTTEntry *e = tt_slot(eng, key);
+    if (e->check != (uint32_t)(key >> 32) || (e->mate_in == 0 && e->no_mate == 0)) return NULL;
+    return e;
+}
+
+static void tt_store(ChessEngine *eng, uint64_t key, int mate_in, int no_mate, const ChessMove *best) {
+    ChessMateTTEntry *e = tt_slot(eng, key);
+    uint32_t check = (uint32_t)(key >> 32);
+    if (e->check != check) {
+        memset(e, 0, sizeof(*e));
+        e->check = check;
+        e->from_sq = e->to_sq = NO_SQ;
+    }
+    if (mate_in && (e->mate_in == 0 || mate_in < e->mate_in)) {
+        e->mate_in = (uint8_t)mate_in;
+        e->from_sq = (uint8_t)(best->from_r * 8 + best->from_c);
+        e->to_sq = (uint8_t)(best->to_r * 8 + best->to_c);
+    }
+    if (no_mate > e->no_mate) e->no_mate = (uint8_t)no_mate;
+}
+
+static int tt_move_is(const ChessMateTTEntry *e, const ChessMove *m) {
+    return e->from_sq == (uint8_t)(m->from_r * 8 + m->from_c) &&
+           e->to_sq == (uint8_t)(m->to_r * 8 + m->to_c);
+}
+
+enum { MATE_ATTACK, MATE_DEFEND };
+enum { FRAME_ENTER, FRAME_CHILD };
+
+static void push_frame(ChessSearchWork *w, int ply, int kind, int n) {
+    ChessSearchFrame *f = &w->frames[ply];
+    f->kind = (uint8_t)kind;
+    f->depth = (int8_t)n;
+    f->ply = (uint8_t)ply;
+    f->phase = FRAME_ENTER;
+    w->top = ply;
+}
+
+/* 压入父帧第 next 个走法的子帧：攻守交替，守方之后的攻方剩余步数减一 */
+static void push_child(ChessSearchWork *w, const ChessSearchFrame *f) {
+    ChessSearchFrame *c = &w->frames[f->ply + 1];
+    c->state = f->state;
+    chess_do_move(&c->state, &w->moves[f->move_base + f->next]);
+    c->move_base = (uint16_t)(f->move_base + f->count);
+    if (f->kind == MATE_ATTACK) push_frame(w, f->ply + 1, MATE_DEFEND, f->depth);
+    else push_frame(w, f->ply + 1, MATE_ATTACK, f->depth - 1);
+}
+
+/*
+ * 攻方节点入口：n 步内能否将死。只保留将军着法，按守方应着数从少到多排进着法池（应着越少越可能成杀），
+ * 置换表着法最先。直接得出结果时写 *value 并返回 1。
+ */
+static int enter_attack(ChessEngine *eng, ChessSearchFrame *f, int *value) {
+    ChessSearchWork *w = &eng->work;
+    const ChessBoardState *state = &f->state;
+    int n = f->depth;
+    w->stats.nodes++;
+    if (check_abort(eng)) { *value = 0; return 1; }
+
+    f->key = chess_zobrist_hash(state);
+    const ChessMateTTEntry *e = tt_probe(eng, f->key);
+    if (e) {
+        w->stats.tt_hits++;
+        if (e->mate_in && e->mate_in <= n) { *value = 1; return 1; }
+        if (e->no_mate >= n) { *value = 0; return 1; }
+    }
+
+    ChessAllMovesList list;
+    chess_all_legal_moves(state, &list);
+    /* 着法池放不下时不做证明（不写表，按未找到处理） */
+    if (f->move_base + list.count > CHESS_SEARCH_MOVE_POOL) { *value = 0; return 1; }
+    ChessMove *checks = &w->moves[f->move_base];
+    uint8_t replies[CHESS_ALL_MOVES_MAX];
+    int count = 0;
+    for (int i = 0; i < list.count; i++) {
+        ChessBoardState next = *state;
+        chess_do_move(&next, &list.moves[i]);
+        w->stats.nodes++;   /* 筛选将军也要走子，计入节点以反映实际开销 */
+        if (!chess_is_king_in_check(&next, next.side_to_move)) continue;
+        ChessAllMovesList evasions;
+        chess_all_legal_moves(&next, &evasions);
+        if (evasions.count == 0) {
+            tt_store(eng, f->key, 1, 0, &list.moves[i]);
+            *value = 1;
+            return 1;
+        }
+        /* 插入排序到前 count 个位置 */
+        uint8_t k = (e && tt_move_is(e, &list.moves[i])) ? 0 : (uint8_t)evasions.count;
+        int j = count++;
+        while (j > 0 && replies[j - 1] > k) {
+            checks[j] = checks[j - 1];
+            replies[j] = replies[j - 1];
+            j--;
+        }
+        checks[j] = list.moves[i];
+        replies[j] = k;
+    }
+    if (n <= 1 || count == 0) {
+        tt_store(eng, f->key, 0, n, NULL);
+        *value = 0;
+        return 1;
+    }
+    f->count = (uint8_t)count;
+    f->next = 0;
+    return 0;
+}
+
+/* 攻方：任一将军之后守方无解即成杀 */
+static int child_attack(ChessEngine *eng, ChessSearchFrame *f, int mated, int *value) {
+    ChessSearchWork *w = &eng->work;
+    if (mated) {
+        w->stats.beta_cutoffs++;
+        if (f->next == 0) w->stats.first_move_cutoffs++;
+        tt_store(eng, f->key, f->depth, 0, &w->moves[f->move_base + f->next]);
+        *value = 1;
+        return 1;
+    }
+    if (++f->next < f->count) return 0;
+    tt_store(eng, f->key, 0, f->depth, NULL);
+    *value = 0;
+    return 1;
+}
+
+/* 守方节点入口（被将军）：展开全部应着，每个之后攻方都须在 n-1 步内将死 */
+static int enter_defend(ChessEngine *eng, ChessSearchFrame *f, int *value) {
+    ChessSearchWork *w = &eng->work;
+    w->stats.nodes++;
+    if (check_abort(eng)) { *value = 0; return 1; }
+    ChessAllMovesList list;
+    chess_all_legal_moves(&f->state, &list);
+    if (list.count == 0) { *value = 1; return 1; }
+    if (f->move_base + list.count > CHESS_SEARCH_MOVE_POOL) { *value = 0; return 1; }
+    memcpy(&w->moves[f->move_base], list.moves, (size_t)list.count * sizeof(ChessMove));
+    f->count = (uint8_t)list.count;
+    f->next = 0;
+    return 0;
+}
+
+static int child_defend(ChessSearchFrame *f, int mated, int *value) {
+    if (!mated) { *value = 0; return 1; }
+    if (++f->next < f->count) return 0;
+    *value = 1;
+    return 1;
+}
+
+/* 运行帧栈直到根攻方节点得出结果（写 *value，返回 1）或本片时间用完（返回 0）；中止时 *value 为 0 */
+static int frames_run(ChessEngine *eng, int *value) {
+    ChessSearchWork *w = &eng->work;
+    for (;;) {
+        ChessSearchFrame *f = &w->frames[w->top];
+        int v;
+        int resolved = 0;
+        if (f->phase == FRAME_ENTER) {
+            if (w->slice_deadline_us && game_clock_us() >= w->slice_deadline_us) return 0;
+            resolved = (f->kind == MATE_ATTACK) ? enter_attack(eng, f, &v) : enter_defend(eng, f, &v);
+            f->phase = FRAME_CHILD;
+        }
+        while (resolved) {
+            if (w->aborted) {
+                w->top = w->base;
+                *value = 0;
+                return 1;
+            }
+            if (w->top == w->base) {
+                *value = v;
+                return 1;
+            }
+            f = &w->frames[--w->top];
+            resolved = (f->kind == MATE_ATTACK) ? child_attack(eng, f, v, &v) : child_defend(f, v, &v);
+        }
+        push_child(w, f);
+    }
+}
+
+/* 在 TT 中的合法走法里找出记录的着法 */
+static int tt_move(const ChessBoardState *state, const ChessMateTTEntry *e, ChessMove *out) {
+    ChessAllMovesList list;
+    chess_all_legal_moves(state, &list);
+    for (int i = 0; i < list.count; i++) {
+        if (tt_move_is(e, &list.moves[i])) {
+            *out = list.moves[i];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* 沿 TT 取 PV：攻方取记录的着法，守方取使剩余杀步最长的应着 */
+static void extract_pv(ChessEngine *eng, const ChessBoardState *root, int n, ChessMateResult *out) {
+    ChessBoardState pos = *root;
+    out->pv_len = 0;
+    while (n > 0 && out->pv_len < 2 * CHESS_MATE_MAX_MOVES) {
+        const ChessMateTTEntry *e = tt_probe(eng, chess_zobrist_hash(&pos));
+        ChessMove m;
+        if (!e || !e->mate_in || !tt_move(&pos, e, &m)) return;
+        out->pv[out->pv_len++] = m;
+        chess_do_move(&pos, &m);
+
+        ChessAllMovesList replies;
+        chess_all_legal_moves(&pos, &replies);
+        if (replies.count == 0 || out->pv_len >= 2 * CHESS_MATE_MAX_MOVES) return;
+        int best_i = -1, longest = 0;
+        for (int i = 0; i < replies.count; i++) {
+            ChessBoardState next = pos;
+            chess_do_move(&next, &replies.moves[i]);
+            const ChessMateTTEntry *r = tt_probe(eng, chess_zobrist_hash(&next));
+            int len = (r && r->mate_in) ? r->mate_in : 0;
+            if (len > longest) { longest = len; best_i = i; }
+        }
+        if (best_i < 0) return;
+        out->pv[out->pv_len++] = replies.moves[best_i];
+        chess_do_move(&pos, &replies.moves[best_i]);
+        n = longest;
+    }
+}
+
+void chess_mate_begin(ChessEngine *eng, ChessMateJob *job, const ChessBoardState *root,
+                      const ChessSearchLimits *limits) {
+    memset(job, 0, sizeof(*job));
+    job->root = *root;
+    job->limits = *limits;
+    job->n = 1;
+    job->max_n = (limits->depth > 0 && limits->depth < CHESS_MATE_MAX_MOVES) ? limits->depth : CHESS_MATE_MAX_MOVES;
+    job->deadline_us = limits->movetime_ms ? game_clock_us() + (uint64_t)limits->movetime_ms * 1000u : 0;
+    job->next_poll = limits->poll_nodes ? limits->poll_nodes : CHESS_SEARCH_POLL_NODES;
+    memset(&eng->mate_tt, 0, sizeof(eng->mate_tt));
+    eng->work.owner = NULL;
+}
+
+/* 结束：写统计并累加到调用方提供的统计 */
+static void mate_finish(ChessMateJob *job) {
+    job->done = 1;
+    chess_search_stats_finish(&job->stats);
+    job->result.stats = job->stats;
+    ChessSearchStats *acc = job->limits.stats;
+    if (acc) {
+        acc->nodes += job->stats.nodes;
+        acc->tt_hits += job->stats.tt_hits;
+        acc->beta_cutoffs += job->stats.beta_cutoffs;
+        acc->first_move_cutoffs += job->stats.first_move_cutoffs;
+        acc->elapsed_us += job->stats.elapsed_us;
+        chess_search_stats_finish(acc);
+    }
+}
+
+int chess_mate_step(ChessEngine *eng, ChessMateJob *job, uint32_t budget_us) {
+    if (job->done) return 1;
+    ChessSearchWork *w = &eng->work;
+    /* 节点数与限时按整个任务计：工作区统计从任务里接着累加 */
+    uint64_t start = game_clock_us();
+    w->limits = &job->limits;
+    w->deadline_us = job->deadline_us;
+    w->slice_deadline_us = budget_us ? start + budget_us : 0;
+    w->stats = job->stats;
+    w->poll_nodes = job->limits.poll_nodes ? job->limits.poll_nodes : CHESS_SEARCH_POLL_NODES;
+    w->next_poll = job->next_poll;
+    w->aborted = 0;
+    int resume = (w->owner == job);
+
+    int finished = 0;
+    while (job->n <= job->max_n) {
+        if (!resume) {
+            w->frames[0].state = job->root;
+            w->frames[0].move_base = 0;
+            w->base = 0;
+            push_frame(w, 0, MATE_ATTACK, job->n);
+            w->owner = job;
+        }
+        resume = 0;
+        int found;
+        if (!frames_run(eng, &found)) break;
+        w->owner = NULL;
+        if (w->aborted) { finished = 1; break; }
+        w->stats.depth = job->n;
+        if (found) {
+            ChessMateResult *out = &job->result;
+            out->found = 1;
+            out->mate_in = job->n;
+            extract_pv(eng, &job->root, job->n, out);
+            if (out->pv_len > 0) out->best = out->pv[0];
+            else out->found = 0;
+            finished = 1;
+            break;
+        }
+        job->n++;
+    }
+    if (job->n > job->max_n) finished = 1;
+    w->stats.elapsed_us += (uint32_t)(game_clock_us() - start);
+    job->stats = w->stats;
+    job->next_poll = w->next_poll;
+    if (finished) mate_finish(job);
+    return finished;
+}
+
+int chess_mate_search(ChessEngine *eng, const ChessBoardState *root, const ChessSearchLimits *limits,
+                      ChessMateResult *out) {
+    ChessMateJob job;
+    chess_mate_begin(eng, &job, root, limits);
+    chess_mate_step(eng, &job, 0);
+    *out = job.result;
+    return out->found;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file chess_mate.h
+ * @brief 杀棋求解（mate-in-N）：攻方只走将军着法，守方走全部应将，按 N=1,2,… 迭代，
+ *        用独立的小置换表（ChessEngine.mate_tt）记录"已证 N 步杀"与"N 步内无杀"，不干扰主搜索的置换表
+ *
+ * 供 AI 在正常搜索前以小预算先找杀，以及 UCI "go mate N" 与主机 chess_epd -m N 的解题模式。
+ * 与主搜索共用引擎的显式帧栈，可按时间分片（chess_mate_begin / chess_mate_step）。
+ */
+
+#ifndef PICO_CODE_CHESS_MATE_H
+#define PICO_CODE_CHESS_MATE_H
+
+#include <stdint.h>
+#include "chess_state.h"
+#include "chess_move.h"
+#include "chess_search.h"
+
+/* 未指定 limits->depth 时的最大步数（攻方着法数） */
+#define CHESS_MATE_MAX_MOVES 8
+
+/* 2^10 项 × 8 字节 = 8KB */
+#ifndef CHESS_MATE_TT_BITS
+#define CHESS_MATE_TT_BITS 10
+#endif
+#define CHESS_MATE_TT_SIZE (1u << CHESS_MATE_TT_BITS)
+
+/** 攻方节点的证明结果：mate_in 为已证的最短杀（0 = 未证），no_mate 为已证无杀的最大步数 */
+typedef struct {
+    uint32_t check;
+    uint8_t mate_in;
+    uint8_t no_mate;
+    uint8_t from_sq;
+    uint8_t to_sq;
+} ChessMateTTEntry;
+
+typedef struct {
+    ChessMateTTEntry entries[CHESS_MATE_TT_SIZE];
+} ChessMateTT;
+
+typedef struct {
+    int found;
+    int mate_in;                            /* 攻方着法数 */
+    ChessMove best;
+    ChessMove pv[2 * CHESS_MATE_MAX_MOVES];  /* 攻守交替，守方取最顽强的应着 */
+    int pv_len;
+    ChessSearchStats stats;                 /* depth 为已完整证伪/证实的步数 */
+} ChessMateResult;
+
+/** 可分片的求解任务：节点数与限时按整个任务计 */
+typedef struct {
+    ChessBoardState root;
+    ChessSearchLimits limits;
+    int n;                      /* 正在证明的步数 */
+    int max_n;
+    int done;
+    uint64_t deadline_us;       /* 0 = 不限时 */
+    uint32_t next_poll;
+    ChessSearchStats stats;     /* 各片累计 */
+    ChessMateResult result;     /* done 后有效 */
+} ChessMateJob;
+
+/**
+ * 为当前行棋方找最短杀。limits->depth 为最大步数 N（0 = CHESS_MATE_MAX_MOVES），
+ * nodes/movetime/stop/poll 与普通搜索含义相同，stats 非 NULL 时累加节点。找到返回 1。
+ */
+int chess_mate_search(ChessEngine *eng, const ChessBoardState *root, const ChessSearchLimits *limits,
+                      ChessMateResult *out);
+
+/** 开始一个分片求解任务（limits 含义同 chess_mate_search，会被拷贝） */
+void chess_mate_begin(ChessEngine *eng, ChessMateJob *job, const ChessBoardState *root,
+                      const ChessSearchLimits *limits);
+
+/** 至多运行约 budget_us 微秒（0 = 不限）；任务结束返回 1，结果在 job->result */
+int chess_mate_step(ChessEngine *eng, ChessMateJob *job, uint32_t budget_us);
+
+#endif /* PICO_CODE_CHESS_MATE_H */
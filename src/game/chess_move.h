@@ -8,13 +8,13 @@
 
 #include <stdint.h>
 
-/* 升变目标：无=-1，否则为棋子索引（后/车/马/象）；第一版一律升后 */
-#define CHESS_PROMOTE_NONE ((int8_t)(-1))
+/* 升变目标：无=0（与 CHESS_EMPTY 相同），否则为升变后棋子编码；第一版一律升后 */
+#define CHESS_PROMOTE_NONE ((int8_t)0)
 
 /** 走法：源格 + 目标格 + 特殊标记（易位/吃过路兵/升变） */
 typedef struct {
     int8_t from_r, from_c, to_r, to_c;
-    int8_t promote_to;  /* CHESS_PROMOTE_NONE 或 升变后棋子索引 */
+    int8_t promote_to;  /* CHESS_PROMOTE_NONE 或 升变后棋子编码 */
     int is_ep;           /* 是否吃过路兵 */
     int is_castle;       /* 是否易位 */
 } ChessMove;
@@ -0,0 +1,83 @@
+/**
+ * @file chess_nnue.c
+ */
+
+#include <string.h>
+#include "chess_types.h"
+#include "chess_state.h"
+#include "chess_move.h"
+#include "chess_nnue.h"
+#include "chess_nnue_net.h"   /* 构建时由 tools/chess_nnue/nnue.py 生成 */
+
+#if CHESS_NNUE_NET_FEATURES != CHESS_NNUE_FEATURES || CHESS_NNUE_NET_HIDDEN != CHESS_NNUE_HIDDEN
+#error "chess_nnue_net.h does not match chess_nnue.h; re-export the network"
+#endif
+
+/* 特征号：视角 persp 下的 (己/敌, 类型, 格)；黑方视角上下翻转，使两方共用一套权重 */
+static int feature_index(int persp, int8_t piece, int r, int c) {
+    int enemy = (int)chess_piece_color(piece) != persp;
+    int row = persp ? r : 7 - r;
+    return ((enemy * 6 + (int)chess_piece_type(piece) - 1) * 64) + row * 8 + c;
+}
+
+static void acc_add(ChessNnueAcc *acc, int8_t piece, int r, int c) {
+    for (int p = 0; p < 2; p++) {
+        const int16_t *w = chess_nnue_w1[feature_index(p, piece, r, c)];
+        int16_t *v = acc->v[p];
+        for (int i = 0; i < CHESS_NNUE_HIDDEN; i++) v[i] = (int16_t)(v[i] + w[i]);
+    }
+}
+
+static void acc_sub(ChessNnueAcc *acc, int8_t piece, int r, int c) {
+    for (int p = 0; p < 2; p++) {
+        const int16_t *w = chess_nnue_w1[feature_index(p, piece, r, c)];
+        int16_t *v = acc->v[p];
+        for (int i = 0; i < CHESS_NNUE_HIDDEN; i++) v[i] = (int16_t)(v[i] - w[i]);
+    }
+}
+
+void chess_nnue_refresh(ChessNnueAcc *acc, const ChessBoardState *b) {
+    for (int p = 0; p < 2; p++)
+        memcpy(acc->v[p], chess_nnue_b1, sizeof(acc->v[p]));
+    for (int r = 0; r < 8; r++)
+        for (int c = 0; c < 8; c++)
+            if (b->board[r][c] != CHESS_EMPTY) acc_add(acc, b->board[r][c], r, c);
+}
+
+/* 与 chess_apply_move 的改动一一对应：走子离开原格、吃子（含过路兵）、到达（或升变）、易位时车跟着走 */
+void chess_nnue_update(ChessNnueAcc *child, const ChessNnueAcc *parent, const ChessBoardState *before,
+                       const ChessMove *m) {
+    int8_t piece = before->board[m->from_r][m->from_c];
+    int8_t captured = before->board[m->to_r][m->to_c];
+    *child = *parent;
+    acc_sub(child, piece, m->from_r, m->from_c);
+    if (m->is_castle) {
+        int r = m->from_r;
+        int rook_from = (m->to_c == 6) ? 7 : 0, rook_to = (m->to_c == 6) ? 5 : 3;
+        int8_t rook = before->board[r][rook_from];
+        acc_sub(child, rook, r, rook_from);
+        acc_add(child, rook, r, rook_to);
+    } else if (m->is_ep) {
+        acc_sub(child, before->board[m->from_r][m->to_c], m->from_r, m->to_c);
+    } else if (captured != CHESS_EMPTY) {
+        acc_sub(child, captured, m->to_r, m->to_c);
+    }
+    acc_add(child, (m->promote_to != CHESS_PROMOTE_NONE) ? m->promote_to : piece, m->to_r, m->to_c);
+}
+
+int chess_nnue_evaluate(const ChessNnueAcc *acc, int side) {
+    int32_t sum = chess_nnue_b2;
+    const int16_t *own = acc->v[side], *opp = acc->v[1 - side];
+    for (int i = 0; i < CHESS_NNUE_HIDDEN; i++) {
+        int a = own[i] < 0 ? 0 : own[i] > CHESS_NNUE_QA ? CHESS_NNUE_QA : own[i];
+        int b = opp[i] < 0 ? 0 : opp[i] > CHESS_NNUE_QA ? CHESS_NNUE_QA : opp[i];
+        sum += a * chess_nnue_w2[i] + b * chess_nnue_w2[CHESS_NNUE_HIDDEN + i];
+    }
+    return (int)(sum * CHESS_NNUE_SCALE / (CHESS_NNUE_QA * CHESS_NNUE_QB));
+}
+
+int chess_nnue_eval(const ChessBoardState *b, int side) {
+    ChessNnueAcc acc;
+    chess_nnue_refresh(&acc, b);
+    return chess_nnue_evaluate(&acc, side);
+}
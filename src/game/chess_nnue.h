@@ -0,0 +1,45 @@
+/**
+ * @file chess_nnue.h
+ * @brief 可选的量化小网络评估（NNUE 式）：768 个输入（己/敌 × 6 种子 × 64 格）→ 每方视角 32 个 int16 隐单元
+ *        （累加器）→ 截断 ReLU → int8 输出层
+ *
+ * 以 CHESS_NNUE=1 编译时搜索叶子改用本评估（CMake 选项 CHESS_NNUE），否则不参与编译。
+ * 第一层权重约 48KB，const 放在 flash；累加器 128 字节，搜索按层各存一份（约 4KB RAM）：
+ * 子节点的累加器 = 父节点的 + 本步增删的几个特征，回溯时直接用父层那份，不做全量重算。
+ * 权重由 tools/chess_nnue/nnue.py 在构建时导出为 chess_nnue_net.h；未指定网络时导出与子力评估等价的网络
+ * （双方子力各不超过 8128 厘兵时分数完全相同，搜索结果也一致）。
+ */
+
+#ifndef PICO_CODE_CHESS_NNUE_H
+#define PICO_CODE_CHESS_NNUE_H
+
+#include <stdint.h>
+#include "chess_state.h"
+#include "chess_move.h"
+
+#define CHESS_NNUE_FEATURES 768
+#define CHESS_NNUE_HIDDEN   32
+/* 量化：隐单元 127 = 1.0（截断上限），输出权重 64 = 1.0；分数 = 输出 × CHESS_NNUE_SCALE 厘兵 */
+#define CHESS_NNUE_QA       127
+#define CHESS_NNUE_QB       64
+#define CHESS_NNUE_SCALE    256
+
+/** 第一层累加器：[视角颜色 0=黑 1=白][隐单元] */
+typedef struct {
+    int16_t v[2][CHESS_NNUE_HIDDEN];
+} ChessNnueAcc;
+
+/** 由局面全量计算累加器 */
+void chess_nnue_refresh(ChessNnueAcc *acc, const ChessBoardState *b);
+
+/** 增量更新：child = parent 加上 before 局面走 m 后增删的特征（before 为走子前的局面） */
+void chess_nnue_update(ChessNnueAcc *child, const ChessNnueAcc *parent, const ChessBoardState *before,
+                       const ChessMove *m);
+
+/** 由累加器求评估：side 方视角，单位厘兵（同 chess_eval_material） */
+int chess_nnue_evaluate(const ChessNnueAcc *acc, int side);
+
+/** 全量计算并评估（非搜索场合、校验用） */
+int chess_nnue_eval(const ChessBoardState *b, int side);
+
+#endif /* PICO_CODE_CHESS_NNUE_H */
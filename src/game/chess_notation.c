@@ -0,0 +1,271 @@
+/**
+ * @file chess_notation.c
+ */
+
+#include <string.h>
+#include "chess_types.h"
+#include "chess_state.h"
+#include "chess_move.h"
+#include "chess_legal.h"
+#include "chess_check.h"
+#include "chess_result.h"
+#include "chess_notation.h"
+
+int chess_move_to_uci(const ChessMove *m, char *out) {
+    int n = 0;
+    out[n++] = CHESS_FILE_CHAR(m->from_c);
+    out[n++] = CHESS_RANK_CHAR(m->from_r);
+    out[n++] = CHESS_FILE_CHAR(m->to_c);
+    out[n++] = CHESS_RANK_CHAR(m->to_r);
+    if (m->promote_to != CHESS_PROMOTE_NONE)
+        out[n++] = 'q';  /* 只生成升后 */
+    out[n] = '\0';
+    return n;
+}
+
+static int parse_square(const char *s, int *r, int *c) {
+    if (s[0] < 'a' || s[0] > 'h' || s[1] < '1' || s[1] > '8') return 0;
+    *c = s[0] - 'a';
+    *r = '8' - s[1];
+    return 1;
+}
+
+int chess_move_from_uci(const ChessBoardState *b, const char *s, ChessMove *out) {
+    int fr, fc, tr, tc;
+    if (!parse_square(s, &fr, &fc) || !parse_square(s + 2, &tr, &tc)) return 0;
+    char promo = s[4];
+    if (promo != '\0' && promo != ' ' && promo != '\n' && promo != '\r' && promo != 'q' && promo != 'Q')
+        return 0;  /* 仅支持升后 */
+
+    ChessAllMovesList list;
+    chess_all_legal_moves(b, &list);
+    for (int i = 0; i < list.count; i++) {
+        const ChessMove *m = &list.moves[i];
+        if (m->from_r == fr && m->from_c == fc && m->to_r == tr && m->to_c == tc) {
+            *out = *m;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int chess_move_equal(const ChessMove *a, const ChessMove *b) {
+    return a->from_r == b->from_r && a->from_c == b->from_c &&
+           a->to_r == b->to_r && a->to_c == b->to_c && a->promote_to == b->promote_to;
+}
+
+/* ---------- SAN ---------- */
+
+/* FEN/SAN 字母，按类型位下标：空/兵/马/象/车/后/王 */
+static const char s_fen_chars[] = " pnbrqk";
+
+int chess_move_to_san(const ChessBoardState *b, const ChessMove *m, char *out) {
+    int n = 0;
+    int8_t piece = b->board[m->from_r][m->from_c];
+    ChessPieceType pt = chess_piece_type(piece);
+    int capture = m->is_ep || b->board[m->to_r][m->to_c] != CHESS_EMPTY;
+
+    if (m->is_castle) {
+        const char *s = (m->to_c == 6) ? "O-O" : "O-O-O";
+        while (*s) out[n++] = *s++;
+    } else {
+        if (pt == CHESS_PIECE_PAWN) {
+            if (capture) out[n++] = CHESS_FILE_CHAR(m->from_c);
+        } else {
+            out[n++] = (char)(s_fen_chars[pt] - 'a' + 'A');
+            /* 同类子可到同一格时按列、行、格的顺序消歧 */
+            ChessAllMovesList list;
+            chess_all_legal_moves(b, &list);
+            int ambiguous = 0, same_file = 0, same_rank = 0;
+            for (int i = 0; i < list.count; i++) {
+                const ChessMove *o = &list.moves[i];
+                if (o->to_r != m->to_r || o->to_c != m->to_c) continue;
+                if (o->from_r == m->from_r && o->from_c == m->from_c) continue;
+                if (b->board[o->from_r][o->from_c] != piece) continue;
+                ambiguous = 1;
+                if (o->from_c == m->from_c) same_file = 1;
+                if (o->from_r == m->from_r) same_rank = 1;
+            }
+            if (ambiguous) {
+                if (!same_file) {
+                    out[n++] = CHESS_FILE_CHAR(m->from_c);
+                } else if (!same_rank) {
+                    out[n++] = CHESS_RANK_CHAR(m->from_r);
+                } else {
+                    out[n++] = CHESS_FILE_CHAR(m->from_c);
+                    out[n++] = CHESS_RANK_CHAR(m->from_r);
+                }
+            }
+        }
+        if (capture) out[n++] = 'x';
+        out[n++] = CHESS_FILE_CHAR(m->to_c);
+        out[n++] = CHESS_RANK_CHAR(m->to_r);
+        if (m->promote_to != CHESS_PROMOTE_NONE) {
+            out[n++] = '=';
+            out[n++] = (char)(s_fen_chars[chess_piece_type(m->promote_to)] - 'a' + 'A');
+        }
+    }
+
+    ChessBoardState next = *b;
+    chess_do_move(&next, m);
+    if (chess_is_king_in_check(&next, next.side_to_move)) {
+        ChessAllMovesList replies;
+        chess_all_legal_moves(&next, &replies);
+        out[n++] = replies.count ? '+' : '#';
+    }
+    out[n] = '\0';
+    return n;
+}
+
+/* 去掉 SAN 中不参与匹配的字符：后缀 +#!?、升变的 '='，并把 0-0 规范成 O-O 写入 out */
+static void san_normalize(const char *s, char *out) {
+    int n = 0;
+    for (; *s && *s != ' ' && *s != '\t' && *s != ';' && *s != ',' && n < CHESS_SAN_MAX - 1; s++) {
+        char ch = *s;
+        if (ch == '+' || ch == '#' || ch == '!' || ch == '?' || ch == '=') continue;
+        if (ch == '0') ch = 'O';
+        out[n++] = ch;
+    }
+    out[n] = '\0';
+}
+
+int chess_move_from_san(const ChessBoardState *b, const char *s, ChessMove *out) {
+    char want[CHESS_SAN_MAX];
+    san_normalize(s, want);
+    if (!want[0]) return 0;
+
+    ChessAllMovesList list;
+    chess_all_legal_moves(b, &list);
+    for (int i = 0; i < list.count; i++) {
+        char san[CHESS_SAN_MAX];
+        char norm[CHESS_SAN_MAX];
+        chess_move_to_san(b, &list.moves[i], san);
+        san_normalize(san, norm);
+        if (strcmp(norm, want) == 0) {
+            *out = list.moves[i];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* ---------- FEN ---------- */
+
+int chess_state_to_fen(const ChessBoardState *b, char *out, int size) {
+    char buf[CHESS_FEN_MAX];
+    int n = 0;
+    for (int r = 0; r < 8; r++) {
+        int empty = 0;
+        for (int c = 0; c < 8; c++) {
+            int8_t p = b->board[r][c];
+            if (p == CHESS_EMPTY) { empty++; continue; }
+            if (empty) { buf[n++] = (char)('0' + empty); empty = 0; }
+            char ch = s_fen_chars[chess_piece_type(p)];
+            buf[n++] = (chess_piece_color(p) == CHESS_COLOR_WHITE) ? (char)(ch - 'a' + 'A') : ch;
+        }
+        if (empty) buf[n++] = (char)('0' + empty);
+        if (r < 7) buf[n++] = '/';
+    }
+    buf[n++] = ' ';
+    buf[n++] = b->side_to_move ? 'w' : 'b';
+    buf[n++] = ' ';
+    int any = 0;
+    if (b->castling[1][1]) { buf[n++] = 'K'; any = 1; }
+    if (b->castling[1][0]) { buf[n++] = 'Q'; any = 1; }
+    if (b->castling[0][1]) { buf[n++] = 'k'; any = 1; }
+    if (b->castling[0][0]) { buf[n++] = 'q'; any = 1; }
+    if (!any) buf[n++] = '-';
+    buf[n++] = ' ';
+    if (b->ep_col >= 0) {
+        buf[n++] = CHESS_FILE_CHAR(b->ep_col);
+        buf[n++] = b->side_to_move ? '6' : '3';
+    } else {
+        buf[n++] = '-';
+    }
+    const char *tail = " 0 1";
+    while (*tail) buf[n++] = *tail++;
+    if (n + 1 > size) return 0;
+    for (int i = 0; i < n; i++) out[i] = buf[i];
+    out[n] = '\0';
+    return 1;
+}
+
+static int8_t fen_piece(char ch) {
+    int color = (ch >= 'A' && ch <= 'Z') ? CHESS_COLOR_WHITE : CHESS_COLOR_BLACK;
+    char lower = (color == CHESS_COLOR_WHITE) ? (char)(ch - 'A' + 'a') : ch;
+    for (int t = CHESS_PIECE_PAWN; t <= CHESS_PIECE_KING; t++)
+        if (s_fen_chars[t] == lower) return CHESS_PIECE(color, t);
+    return CHESS_EMPTY;
+}
+
+int chess_state_from_fen(ChessBoardState *out, const char *s, const char **end) {
+    ChessBoardState tmp;
+    ChessBoardState *b = &tmp;
+    while (*s == ' ' || *s == '\t') s++;
+    int r = 0, c = 0;
+    for (; *s && *s != ' '; s++) {
+        if (*s == '/') {
+            if (c != 8 || ++r > 7) return 0;
+            c = 0;
+        } else if (*s >= '1' && *s <= '8') {
+            for (int k = *s - '0'; k > 0; k--) {
+                if (c > 7) return 0;
+                b->board[r][c++] = CHESS_EMPTY;
+            }
+        } else {
+            int8_t p = fen_piece(*s);
+            if (p == CHESS_EMPTY || c > 7) return 0;
+            b->board[r][c++] = p;
+        }
+    }
+    if (r != 7 || c != 8) return 0;
+
+    while (*s == ' ' || *s == '\t') s++;
+    if (*s == 'w') b->side_to_move = 1;
+    else if (*s == 'b') b->side_to_move = 0;
+    else return 0;
+    s++;
+
+    while (*s == ' ' || *s == '\t') s++;
+    b->castling[0][0] = b->castling[0][1] = 0;
+    b->castling[1][0] = b->castling[1][1] = 0;
+    if (*s == '-') {
+        s++;
+    } else {
+        for (; *s && *s != ' '; s++) {
+            switch (*s) {
+                case 'K': b->castling[1][1] = 1; break;
+                case 'Q': b->castling[1][0] = 1; break;
+                case 'k': b->castling[0][1] = 1; break;
+                case 'q': b->castling[0][0] = 1; break;
+                default: return 0;
+            }
+        }
+    }
+    /* 王或车不在原位的易位权与盘面矛盾，丢弃（否则空盘上的 "KQkq" 也能生成易位着法） */
+    for (int color = 0; color < 2; color++) {
+        int home = color == CHESS_COLOR_WHITE ? 7 : 0;
+        if (b->board[home][4] != CHESS_PIECE(color, CHESS_PIECE_KING))
+            b->castling[color][0] = b->castling[color][1] = 0;
+        if (b->board[home][0] != CHESS_PIECE(color, CHESS_PIECE_ROOK)) b->castling[color][0] = 0;
+        if (b->board[home][7] != CHESS_PIECE(color, CHESS_PIECE_ROOK)) b->castling[color][1] = 0;
+    }
+
+    while (*s == ' ' || *s == '\t') s++;
+    b->ep_col = -1;
+    if (*s >= 'a' && *s <= 'h') {
+        if (s[1] != (b->side_to_move ? '6' : '3')) return 0;
+        b->ep_col = *s - 'a';
+        s += 2;
+    } else if (*s == '-') {
+        s++;
+    } else {
+        return 0;
+    }
+    if (*s != '\0' && *s != ' ' && *s != '\t' && *s != '\r' && *s != '\n') return 0;
+    /* 半回合/回合计数由调用方忽略 */
+    *out = tmp;
+    if (end) *end = s;
+    return 1;
+}
+
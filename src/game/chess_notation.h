@@ -0,0 +1,44 @@
+/**
+ * @file chess_notation.h
+ * @brief 记法：格名、UCI 长代数着法（e2e4 / e7e8q）、标准代数着法 SAN（Nf3 / exd5 / O-O）与 FEN 局面互转
+ */
+
+#ifndef PICO_CODE_CHESS_NOTATION_H
+#define PICO_CODE_CHESS_NOTATION_H
+
+#include "chess_state.h"
+#include "chess_move.h"
+
+/* 行 0 为第 8 横线，列 0 为 a 线 */
+#define CHESS_FILE_CHAR(c) ((char)('a' + (c)))
+#define CHESS_RANK_CHAR(r) ((char)('8' - (r)))
+
+/** 着法写成 UCI 字符串，out 至少 6 字节；返回写入长度 */
+int chess_move_to_uci(const ChessMove *m, char *out);
+
+/** 解析 UCI 着法并在当前局面的合法走法中匹配；成功写入 *out 返回 1 */
+int chess_move_from_uci(const ChessBoardState *b, const char *s, ChessMove *out);
+
+/** 比较两步是否为同一着法（源格、目标格、升变） */
+int chess_move_equal(const ChessMove *a, const ChessMove *b);
+
+/* SAN 最长如 "Qa1xb2=Q+"，FEN 最长约 90 字符 */
+#define CHESS_SAN_MAX 12
+#define CHESS_FEN_MAX 100
+
+/** 合法着法 m 写成 SAN（含 +/# 后缀），out 至少 CHESS_SAN_MAX 字节；返回写入长度 */
+int chess_move_to_san(const ChessBoardState *b, const ChessMove *m, char *out);
+
+/** 解析 SAN（忽略 +#!? 后缀与升变的 '='，接受 0-0）并匹配合法走法；成功返回 1 */
+int chess_move_from_san(const ChessBoardState *b, const char *s, ChessMove *out);
+
+/**
+ * 解析 FEN 的前四段（棋盘、行棋方、易位、吃过路兵）；半回合/回合计数不保存。
+ * 成功返回 1 并写 *b，end 非 NULL 时指向第四段之后（EPD 的操作从这里开始）；格式错误返回 0，*b 不变。
+ */
+int chess_state_from_fen(ChessBoardState *b, const char *fen, const char **end);
+
+/** 写 FEN（含结尾 '\0'，计数固定为 "0 1"），缓冲不足返回 0 */
+int chess_state_to_fen(const ChessBoardState *b, char *out, int size);
+
+#endif /* PICO_CODE_CHESS_NOTATION_H */
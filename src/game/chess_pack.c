@@ -0,0 +1,85 @@
+/**
+ * @file chess_pack.c
+ */
+
+#include <stddef.h>
+#include "chess_types.h"
+#include "chess_state.h"
+#include "chess_notation.h"
+#include "chess_pack.h"
+
+#define META_SIDE         1u
+#define META_CASTLE_SHIFT 1
+#define META_EP_SHIFT     5
+
+int chess_pack_encode(const ChessBoardState *b, ChessPackedPos *out) {
+    const int8_t *sq = &b->board[0][0];
+    uint64_t occ = 0;
+    uint64_t codes[2] = { 0, 0 };
+    int n = 0;
+    for (int i = 0; i < 64; i++) {
+        if (sq[i] == CHESS_EMPTY) continue;
+        if (n >= 32) return 0;
+        occ |= 1ull << i;
+        codes[n >> 4] |= (uint64_t)(sq[i] & 0x0F) << ((n & 15) * 4);
+        n++;
+    }
+    uint64_t meta = b->side_to_move ? META_SIDE : 0;
+    for (int color = 0; color < 2; color++)
+        for (int wing = 0; wing < 2; wing++)
+            if (b->castling[color][wing]) meta |= 1ull << (META_CASTLE_SHIFT + color * 2 + wing);
+    if (b->ep_col >= 0) meta |= (uint64_t)(b->ep_col + 1) << META_EP_SHIFT;
+    out->occ = occ;
+    out->codes[0] = codes[0];
+    out->codes[1] = codes[1];
+    out->meta = meta;
+    return 1;
+}
+
+int chess_pack_decode(const ChessPackedPos *p, ChessBoardState *out) {
+    int8_t *sq = &out->board[0][0];
+    for (int i = 0; i < 64; i++) sq[i] = CHESS_EMPTY;
+    uint64_t occ = p->occ;
+    int n = 0;
+    while (occ) {
+        if (n >= 32) return 0;
+        int i = __builtin_ctzll(occ);
+        occ &= occ - 1;
+        int8_t code = (int8_t)((p->codes[n >> 4] >> ((n & 15) * 4)) & 0x0F);
+        ChessPieceType t = chess_piece_type(code);
+        if (t < CHESS_PIECE_PAWN || t > CHESS_PIECE_KING) return 0;
+        sq[i] = code;
+        n++;
+    }
+    out->side_to_move = (p->meta & META_SIDE) ? 1 : 0;
+    for (int color = 0; color < 2; color++)
+        for (int wing = 0; wing < 2; wing++)
+            out->castling[color][wing] = (p->meta >> (META_CASTLE_SHIFT + color * 2 + wing)) & 1;
+    out->ep_col = (int)((p->meta >> META_EP_SHIFT) & 0x0F) - 1;
+    if (out->ep_col > 7) return 0;
+    return 1;
+}
+
+static int cmp_u64(uint64_t a, uint64_t b) {
+    return (a > b) - (a < b);
+}
+
+int chess_pack_compare(const ChessPackedPos *a, const ChessPackedPos *b) {
+    int c = cmp_u64(a->occ, b->occ);
+    if (c == 0) c = cmp_u64(a->codes[0], b->codes[0]);
+    if (c == 0) c = cmp_u64(a->codes[1], b->codes[1]);
+    if (c == 0) c = cmp_u64(a->meta, b->meta);
+    return c;
+}
+
+int chess_pack_to_fen(const ChessPackedPos *p, char *out, int size) {
+    ChessBoardState b;
+    if (!chess_pack_decode(p, &b)) return 0;
+    return chess_state_to_fen(&b, out, size);
+}
+
+int chess_pack_from_fen(const char *fen, ChessPackedPos *out) {
+    ChessBoardState b;
+    if (!chess_state_from_fen(&b, fen, NULL)) return 0;
+    return chess_pack_encode(&b, out);
+}
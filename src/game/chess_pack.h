@@ -0,0 +1,48 @@
+/**
+ * @file chess_pack.h
+ * @brief 紧凑局面编码（32 字节）：占位位图 + 每个有子格 4 位棋子编码 + 行棋方/易位/吃过路兵，及与 FEN 互转
+ *
+ * 编码是规范的：同一局面只有一种字节表示（未用位恒为 0），可直接按字比较或 memcmp，
+ * 供局面历史、开局库与挂起/恢复快照使用。FEN 的半回合/回合计数不保存，输出固定为 "0 1"。
+ */
+
+#ifndef PICO_CODE_CHESS_PACK_H
+#define PICO_CODE_CHESS_PACK_H
+
+#include <stdint.h>
+#include "chess_state.h"
+#include "chess_notation.h"
+
+/**
+ * 压缩局面：
+ *   occ      bit (r*8+c) 置位表示该格有子（r=0 为第 8 横线）
+ *   codes    按 occ 中格号从小到大，第 i 个子的编码放在第 i 个半字节（codes[i/16] 的 bit 4*(i%16)）
+ *   meta     bit0 行棋方（1=白），bit1..4 易位资格（黑后、黑王、白后、白王翼），bit5..8 吃过路兵列+1（0=无）
+ */
+typedef struct {
+    uint64_t occ;
+    uint64_t codes[2];
+    uint64_t meta;
+} ChessPackedPos;
+
+/** 编码：超过 32 子（非法局面）返回 0 */
+int chess_pack_encode(const ChessBoardState *b, ChessPackedPos *out);
+
+/** 解码：编码损坏（子数超限、子类型不在兵..王、吃过路兵列超出 a..h）返回 0 */
+int chess_pack_decode(const ChessPackedPos *p, ChessBoardState *out);
+
+static inline int chess_pack_equal(const ChessPackedPos *a, const ChessPackedPos *b) {
+    return ((a->occ ^ b->occ) | (a->codes[0] ^ b->codes[0]) |
+            (a->codes[1] ^ b->codes[1]) | (a->meta ^ b->meta)) == 0;
+}
+
+/** 全序比较（按 occ、codes、meta 逐字），返回 -1/0/1；用于有序开局库的二分查找 */
+int chess_pack_compare(const ChessPackedPos *a, const ChessPackedPos *b);
+
+/** 写 FEN（见 chess_state_to_fen），解码失败或缓冲不足返回 0 */
+int chess_pack_to_fen(const ChessPackedPos *p, char *out, int size);
+
+/** 解析 FEN（见 chess_state_from_fen），格式错误返回 0 */
+int chess_pack_from_fen(const char *fen, ChessPackedPos *out);
+
+#endif /* PICO_CODE_CHESS_PACK_H */
@@ -139,7 +139,7 @@ static const uint8_t chess_piece_small_11[98] = {
     0x00, 0x00,
 };
 
-/* 索引 0..11 与 chess_types 棋子索引一致 */
+/* 精灵索引 0..11：黑象王马兵后车、白象王马兵后车；棋子编码经 CHESS_PIECE_SPRITE 换算 */
 static const uint8_t* const chess_pieces_small[12] = {
     chess_piece_small_0,
     chess_piece_small_1,
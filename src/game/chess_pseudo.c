@@ -13,9 +13,9 @@ static const int KING_DC[] = { -1,  0,  1, -1,  1, -1,  0,  1 };
 static const int KNIGHT_DR[] = { -2, -2, -1, -1,  1,  1,  2,  2 };
 static const int KNIGHT_DC[] = { -1,  1, -2,  2, -2,  2, -1,  1 };
 
-/* 升变仅后：白后=10，黑后=4 */
-static const int8_t PROMO_QUEEN_WHITE = 10;
-static const int8_t PROMO_QUEEN_BLACK = 4;
+/* 升变仅后 */
+#define PROMO_QUEEN_WHITE CHESS_PIECE(CHESS_COLOR_WHITE, CHESS_PIECE_QUEEN)
+#define PROMO_QUEEN_BLACK CHESS_PIECE(CHESS_COLOR_BLACK, CHESS_PIECE_QUEEN)
 
 static void ray_moves(const ChessBoardState *b, int r, int c, int dr, int dc, ChessMoveList *out) {
     int side = b->side_to_move;
@@ -136,7 +136,7 @@ void chess_pseudo_pawn(const ChessBoardState *b, int r, int c, ChessMoveList *ou
 void chess_pseudo_moves_from(const ChessBoardState *b, int r, int c, ChessMoveList *out) {
     chess_move_list_clear(out);
     if (!chess_state_in_bounds(r, c) || b->board[r][c] == CHESS_EMPTY) return;
-    ChessPieceType t = chess_piece_index_to_type(b->board[r][c]);
+    ChessPieceType t = chess_piece_type(b->board[r][c]);
     switch (t) {
         case CHESS_PIECE_KING:   chess_pseudo_king(b, r, c, out); break;
         case CHESS_PIECE_QUEEN:  chess_pseudo_queen(b, r, c, out); break;
@@ -0,0 +1,48 @@
+/**
+ * @file chess_record.c
+ */
+
+#include <stdlib.h>
+#include "chess_types.h"
+#include "chess_state.h"
+#include "chess_move.h"
+#include "chess_legal.h"
+#include "chess_pack.h"
+#include "chess_record.h"
+
+void chess_record_init(ChessGameRecord *rec, const ChessBoardState *start) {
+    chess_pack_encode(start, &rec->start);
+    rec->count = 0;
+}
+
+int chess_record_push(ChessGameRecord *rec, const ChessMove *m) {
+    if (rec->count >= CHESS_GAME_MAX_PLIES) return 0;
+    rec->moves[rec->count].from_sq = (uint8_t)(m->from_r * 8 + m->from_c);
+    rec->moves[rec->count].to_sq = (uint8_t)(m->to_r * 8 + m->to_c);
+    rec->count++;
+    return 1;
+}
+
+void chess_record_expand(const ChessBoardState *b, const ChessGameMove *gm, ChessMove *out) {
+    out->from_r = (int8_t)(gm->from_sq / 8);
+    out->from_c = (int8_t)(gm->from_sq % 8);
+    out->to_r = (int8_t)(gm->to_sq / 8);
+    out->to_c = (int8_t)(gm->to_sq % 8);
+    int8_t piece = b->board[out->from_r][out->from_c];
+    ChessPieceType pt = chess_piece_type(piece);
+    out->is_castle = (pt == CHESS_PIECE_KING && abs(out->to_c - out->from_c) == 2);
+    out->is_ep = (pt == CHESS_PIECE_PAWN && out->to_c != out->from_c &&
+                  b->board[out->to_r][out->to_c] == CHESS_EMPTY);
+    out->promote_to = (pt == CHESS_PIECE_PAWN && (out->to_r == 0 || out->to_r == 7))
+                          ? CHESS_PIECE(chess_piece_color(piece), CHESS_PIECE_QUEEN) : CHESS_PROMOTE_NONE;
+}
+
+int chess_record_position(const ChessGameRecord *rec, int ply, ChessBoardState *out) {
+    if (ply < 0 || ply > rec->count || !chess_pack_decode(&rec->start, out)) return 0;
+    for (int i = 0; i < ply; i++) {
+        ChessMove m;
+        chess_record_expand(out, &rec->moves[i], &m);
+        chess_do_move(out, &m);
+    }
+    return 1;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file chess_record.h
+ * @brief 对局记录：起始局面（32 字节压缩编码）+ 着法序列（每步 2 字节：源格、目标格），可回放到任一半回合
+ *
+ * 着法只存格号（同置换表），易位/吃过路兵/升变（一律升后）在回放时由棋盘推出。
+ */
+
+#ifndef PICO_CODE_CHESS_RECORD_H
+#define PICO_CODE_CHESS_RECORD_H
+
+#include <stdint.h>
+#include "chess_state.h"
+#include "chess_move.h"
+#include "chess_pack.h"
+
+/* 最多记录的半回合数；超出后不再记录（分析只覆盖已记录部分） */
+#ifndef CHESS_GAME_MAX_PLIES
+#define CHESS_GAME_MAX_PLIES 256
+#endif
+
+typedef struct {
+    uint8_t from_sq;    /* r*8+c */
+    uint8_t to_sq;
+} ChessGameMove;
+
+typedef struct {
+    ChessPackedPos start;
+    ChessGameMove moves[CHESS_GAME_MAX_PLIES];
+    int count;
+} ChessGameRecord;
+
+void chess_record_init(ChessGameRecord *rec, const ChessBoardState *start);
+
+/** 追加一步（m 须为当前局面的合法着法）；已满返回 0 */
+int chess_record_push(ChessGameRecord *rec, const ChessMove *m);
+
+/** 由走子前的局面把记录的一步还原为完整着法 */
+void chess_record_expand(const ChessBoardState *b, const ChessGameMove *gm, ChessMove *out);
+
+/** 第 ply 步的行棋方（0=黑 1=白） */
+static inline int chess_record_side(const ChessGameRecord *rec, int ply) {
+    return (int)((rec->start.meta & 1u) ^ ((unsigned)ply & 1u));
+}
+
+/** 第 ply 步走子前的局面（ply = count 为最后局面）；ply 越界返回 0 */
+int chess_record_position(const ChessGameRecord *rec, int ply, ChessBoardState *out);
+
+#endif /* PICO_CODE_CHESS_RECORD_H */
@@ -0,0 +1,586 @@
+/**
+ * @file chess_search.c
+ * @brief 迭代加深 + Alpha-Beta + 只搜吃子的静态搜索 + 置换表；PV 用三角表，
+ *        着法排序：TT 着法 → PV → MVV-LVA 吃子/升变 → 杀手着法 → 历史分
+ *
+ * 全部状态在 ChessEngine（置换表、杀手/历史表、工作区 eng->work），本文件没有静态变量。
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "chess_types.h"
+#include "chess_state.h"
+#include "chess_move.h"
+#include "chess_check.h"
+#include "chess_legal.h"
+#include "chess_result.h"
+#include "chess_eval.h"
+#if CHESS_NNUE
+#include "chess_nnue.h"
+#endif
+#include "chess_notation.h"
+#include "chess_search.h"
+#include "chess_trace.h"
+#include "chess_tt.h"
+#include "chess_engine.h"
+#include "chess_zobrist.h"
+#include "game_clock.h"
+
+#if CHESS_SEARCH_TRACE
+#define TRACE_NODE(ply, m, cutoff, alpha, beta, score, nmoves, flags) \
+    chess_trace_record((ply), (m) ? (m)->from_r * 8 + (m)->from_c : CHESS_TRACE_NO_MOVE, \
+                       (m) ? (m)->to_r * 8 + (m)->to_c : CHESS_TRACE_NO_MOVE, \
+                       (cutoff), (alpha), (beta), (score), (nmoves), (flags))
+#define TRACE_RESET() chess_trace_reset()
+#else
+#define TRACE_NODE(ply, m, cutoff, alpha, beta, score, nmoves, flags) ((void)0)
+#define TRACE_RESET() ((void)0)
+#endif
+
+/* 排序分档：吃子/升变 > 杀手 > 历史分（历史分封顶在杀手档以下） */
+#define ORDER_CAPTURE (1 << 17)
+#define ORDER_KILLER  (1 << 16)
+#define HISTORY_MAX   ((1 << 16) - 1)
+
+void chess_search_limits_init(ChessSearchLimits *l) {
+    memset(l, 0, sizeof(*l));
+}
+
+void chess_search_stats_clear(ChessSearchStats *st) {
+    memset(st, 0, sizeof(*st));
+}
+
+void chess_search_stats_finish(ChessSearchStats *st) {
+    st->nps = st->elapsed_us ? (uint32_t)((uint64_t)st->nodes * 1000000u / st->elapsed_us) : 0;
+}
+
+int chess_search_stats_format(const ChessSearchStats *st, char *buf, int size) {
+    uint32_t cut_pct10 = st->beta_cutoffs ? (uint32_t)((uint64_t)st->first_move_cutoffs * 1000u / st->beta_cutoffs) : 0;
+    return snprintf(buf, (size_t)size,
+                    "depth %d nodes %lu qnodes %lu tthits %lu cutoffs %lu first %lu (%lu.%lu%%) time %luus nps %lu",
+                    st->depth, (unsigned long)st->nodes, (unsigned long)st->qnodes,
+                    (unsigned long)st->tt_hits, (unsigned long)st->beta_cutoffs,
+                    (unsigned long)st->first_move_cutoffs,
+                    (unsigned long)(cut_pct10 / 10), (unsigned long)(cut_pct10 % 10),
+                    (unsigned long)st->elapsed_us, (unsigned long)st->nps);
+}
+
+static int check_abort(ChessEngine *eng) {
+    ChessSearchWork *w = &eng->work;
+    if (w->aborted) return 1;
+    if (w->stats.nodes < w->next_poll) return 0;
+    w->next_poll = w->stats.nodes + w->poll_nodes;
+    if (w->limits->nodes && w->stats.nodes >= w->limits->nodes) w->aborted = 1;
+    else if (w->deadline_us && game_clock_us() >= w->deadline_us) w->aborted = 1;
+    else if (eng->abort) w->aborted = 1;
+    else if (w->limits->poll && w->limits->poll(w->limits->poll_user)) w->aborted = 1;
+    return w->aborted;
+}
+
+static int is_capture(const ChessBoardState *b, const ChessMove *m) {
+    return m->is_ep || b->board[m->to_r][m->to_c] != CHESS_EMPTY;
+}
+
+/**
+ * 排序分：TT 着法最高，PV 着法次之，其后按 MVV-LVA 的吃子与升变；
+ * 安静着法按本层杀手着法、历史分（ply < 0 时不用，如静态搜索）
+ */
+static int move_order_score(const ChessEngine *eng, const ChessBoardState *b, const ChessMove *m,
+                            const ChessMove *pv_move, const ChessTTEntry *tt, int ply) {
+    if (tt && chess_tt_move_is(tt, m)) return 1 << 21;
+    if (pv_move && chess_move_equal(m, pv_move)) return 1 << 20;
+    int s = 0;
+    if (m->is_ep)
+        s += 10 * chess_piece_value(b->board[m->from_r][m->to_c]);
+    else if (b->board[m->to_r][m->to_c] != CHESS_EMPTY)
+        s += 10 * chess_piece_value(b->board[m->to_r][m->to_c]) - chess_piece_value(b->board[m->from_r][m->from_c]) / 10;
+    if (m->promote_to != CHESS_PROMOTE_NONE)
+        s += 10 * chess_piece_value(m->promote_to);
+    if (s > 0 || ply < 0) return ORDER_CAPTURE + s;
+    if (chess_move_equal(m, &eng->killers[ply][0])) return ORDER_KILLER + 1;
+    if (chess_move_equal(m, &eng->killers[ply][1])) return ORDER_KILLER;
+    return eng->history[b->board[m->from_r][m->from_c]][m->to_r * 8 + m->to_c];
+}
+
+static void order_moves(const ChessEngine *eng, const ChessBoardState *b, ChessAllMovesList *list,
+                        const ChessMove *pv_move, const ChessTTEntry *tt, int ply) {
+    int keys[CHESS_ALL_MOVES_MAX];
+    for (int i = 0; i < list->count; i++)
+        keys[i] = move_order_score(eng, b, &list->moves[i], pv_move, tt, ply);
+    for (int i = 1; i < list->count; i++) {
+        ChessMove m = list->moves[i];
+        int k = keys[i];
+        int j = i;
+        while (j > 0 && keys[j - 1] < k) {
+            list->moves[j] = list->moves[j - 1];
+            keys[j] = keys[j - 1];
+            j--;
+        }
+        list->moves[j] = m;
+        keys[j] = k;
+    }
+}
+
+/* 安静着法产生剪枝：记为本层杀手，历史分按 depth² 累加，封顶时整表减半 */
+static void note_quiet_cutoff(ChessEngine *eng, const ChessBoardState *b, const ChessMove *m, int depth, int ply) {
+    if (!chess_move_equal(m, &eng->killers[ply][0])) {
+        eng->killers[ply][1] = eng->killers[ply][0];
+        eng->killers[ply][0] = *m;
+    }
+    uint16_t *h = &eng->history[b->board[m->from_r][m->from_c]][m->to_r * 8 + m->to_c];
+    int v = *h + depth * depth;
+    if (v > HISTORY_MAX) {
+        for (int p = 0; p < CHESS_PIECE_CODES; p++)
+            for (int sq = 0; sq < 64; sq++)
+                eng->history[p][sq] >>= 1;
+        v = *h + depth * depth;
+        if (v > HISTORY_MAX) v = HISTORY_MAX;
+    }
+    *h = (uint16_t)v;
+}
+
+/* 杀棋分存表时换算为相对当前节点，取出时换回相对根 */
+static int score_to_tt(int score, int ply) {
+    if (score > CHESS_SEARCH_MATE_BOUND) return score + ply;
+    if (score < -CHESS_SEARCH_MATE_BOUND) return score - ply;
+    return score;
+}
+
+static int score_from_tt(int score, int ply) {
+    if (score > CHESS_SEARCH_MATE_BOUND) return score - ply;
+    if (score < -CHESS_SEARCH_MATE_BOUND) return score + ply;
+    return score;
+}
+
+/* ---------- 显式栈 ---------- */
+
+enum { FRAME_SEARCH, FRAME_QUIESCE };
+enum { FRAME_ENTER, FRAME_CHILD };
+
+static void frame_init(ChessSearchWork *w, ChessSearchFrame *f, int depth, int ply, int alpha, int beta) {
+    f->depth = (int8_t)depth;
+    f->ply = (uint8_t)ply;
+    f->alpha = alpha;
+    f->beta = beta;
+    f->kind = (depth <= 0 && !w->limits->no_quiesce) ? FRAME_QUIESCE : FRAME_SEARCH;
+    f->phase = FRAME_ENTER;
+}
+
+/* 以 state 为根压入第一帧（ply 为根所在层：完整搜索为 0，根走法之后的子树为 1） */
+static void push_root(ChessEngine *eng, const ChessBoardState *state, int depth, int ply, int alpha, int beta) {
+    ChessSearchWork *w = &eng->work;
+    ChessSearchFrame *f = &w->frames[ply];
+    f->state = *state;
+    f->move_base = 0;
+#if CHESS_NNUE
+    chess_nnue_refresh(&w->acc[ply], state);
+#endif
+    frame_init(w, f, depth, ply, alpha, beta);
+    w->base = w->top = ply;
+    w->owner = NULL;
+}
+
+/* 压入父帧第 next 个走法的子帧：窗口取反，走法池接在父帧之后 */
+static void push_child(ChessSearchWork *w, const ChessSearchFrame *f) {
+    ChessSearchFrame *c = &w->frames[f->ply + 1];
+    c->state = f->state;
+    chess_do_move(&c->state, &w->moves[f->move_base + f->next]);
+#if CHESS_NNUE
+    chess_nnue_update(&w->acc[f->ply + 1], &w->acc[f->ply], &f->state, &w->moves[f->move_base + f->next]);
+#endif
+    c->move_base = (uint16_t)(f->move_base + f->count);
+    if (f->kind == FRAME_QUIESCE) {
+        frame_init(w, c, 0, f->ply + 1, -f->beta, -f->alpha);
+        c->kind = FRAME_QUIESCE;
+    } else {
+        frame_init(w, c, f->depth - 1, f->ply + 1, -f->beta, -f->alpha);
+    }
+    w->top = f->ply + 1;
+}
+
+/* 静态评估（行棋方视角）：CHESS_NNUE 时用本层累加器，否则数子力 */
+static int frame_eval(const ChessSearchWork *w, const ChessSearchFrame *f) {
+#if CHESS_NNUE
+    return chess_nnue_evaluate(&w->acc[f->ply], f->state.side_to_move);
+#else
+    (void)w;
+    return chess_eval_material(&f->state, f->state.side_to_move);
+#endif
+}
+
+/* 把排好序的走法放进着法池；放不下返回 0 */
+static int frame_store_moves(ChessSearchWork *w, ChessSearchFrame *f, const ChessAllMovesList *list) {
+    if (f->move_base + list->count > CHESS_SEARCH_MOVE_POOL) return 0;
+    memcpy(&w->moves[f->move_base], list->moves, (size_t)list->count * sizeof(ChessMove));
+    f->count = (uint8_t)list->count;
+    f->next = 0;
+    return 1;
+}
+
+/** 静态搜索节点入口：站桩评估 + 只展开吃子/升变。直接得出结果时写 *value 并返回 1 */
+static int enter_quiesce(ChessEngine *eng, ChessSearchFrame *f, int *value) {
+    ChessSearchWork *w = &eng->work;
+    const ChessBoardState *state = &f->state;
+    int ply = f->ply;
+    w->stats.nodes++;
+    w->stats.qnodes++;
+    if (check_abort(eng)) { *value = 0; return 1; }
+
+    int stand = frame_eval(w, f);
+    if (ply >= CHESS_SEARCH_MAX_PLY - 1 || stand >= f->beta) {
+        TRACE_NODE(ply, (const ChessMove *)0, CHESS_TRACE_NO_CUTOFF, f->alpha, f->beta, stand, 0,
+                   CHESS_TRACE_F_QUIESCE | CHESS_TRACE_F_LEAF);
+        *value = stand;
+        return 1;
+    }
+    f->alpha_orig = f->alpha;
+    if (stand > f->alpha) f->alpha = stand;
+
+    ChessAllMovesList list;
+    chess_all_legal_moves(state, &list);
+    if (list.count == 0) {
+        int mated = chess_is_king_in_check(state, state->side_to_move) ? -(CHESS_SEARCH_MATE - ply) : 0;
+        TRACE_NODE(ply, (const ChessMove *)0, CHESS_TRACE_NO_CUTOFF, f->alpha_orig, f->beta, mated, 0,
+                   CHESS_TRACE_F_QUIESCE | CHESS_TRACE_F_LEAF);
+        *value = mated;
+        return 1;
+    }
+    f->nmoves = (uint8_t)list.count;
+    int n = 0;
+    for (int i = 0; i < list.count; i++)
+        if (is_capture(state, &list.moves[i]) || list.moves[i].promote_to != CHESS_PROMOTE_NONE)
+            list.moves[n++] = list.moves[i];
+    list.count = n;
+    f->best = stand;
+    f->best_i = 0xFF;
+    order_moves(eng, state, &list, NULL, NULL, -1);
+    if (!frame_store_moves(w, f, &list)) f->count = 0;
+    return 0;
+}
+
+static int finish_quiesce(ChessSearchWork *w, const ChessSearchFrame *f, int cutoff) {
+    TRACE_NODE(f->ply, f->best_i == 0xFF ? (const ChessMove *)0 : &w->moves[f->move_base + f->best_i], cutoff,
+               f->alpha_orig, f->beta, f->best, f->nmoves, CHESS_TRACE_F_QUIESCE);
+    (void)w; (void)cutoff;
+    return f->best;
+}
+
+/* 子节点返回：更新本层最佳；本层结束时写 *value 并返回 1 */
+static int child_quiesce(ChessEngine *eng, ChessSearchFrame *f, int score, int *value) {
+    ChessSearchWork *w = &eng->work;
+    if (score > f->best) { f->best = score; f->best_i = f->next; }
+    if (score > f->alpha) f->alpha = score;
+    if (f->alpha >= f->beta) {
+        w->stats.beta_cutoffs++;
+        if (f->next == 0) w->stats.first_move_cutoffs++;
+        *value = finish_quiesce(w, f, f->next);
+        return 1;
+    }
+    f->next++;
+    return 0;
+}
+
+/** Negamax + Alpha-Beta 节点入口（行棋方视角，越大越有利）。直接得出结果时写 *value 并返回 1 */
+static int enter_search(ChessEngine *eng, ChessSearchFrame *f, int *value) {
+    ChessSearchWork *w = &eng->work;
+    const ChessBoardState *state = &f->state;
+    int ply = f->ply, depth = f->depth, alpha = f->alpha, beta = f->beta;
+    w->stats.nodes++;
+    if (check_abort(eng)) { *value = 0; return 1; }
+
+    f->key = chess_zobrist_hash(state);
+    ChessTTEntry tt;
+    int tt_hit = chess_tt_probe(&eng->tt, f->key, &tt);
+    if (tt_hit) w->stats.tt_hits++;
+    if (tt_hit && ply > 0 && tt.depth >= depth) {
+        int s = score_from_tt(tt.score, ply);
+        if (tt.bound == CHESS_TT_EXACT ||
+            (tt.bound == CHESS_TT_LOWER && s >= beta) ||
+            (tt.bound == CHESS_TT_UPPER && s <= alpha)) {
+#if CHESS_SEARCH_TRACE
+            chess_trace_record(ply, tt.from_sq, tt.to_sq, CHESS_TRACE_NO_CUTOFF, alpha, beta, s, 0,
+                               CHESS_TRACE_F_TT);
+#endif
+            *value = s;
+            return 1;
+        }
+    }
+
+    ChessAllMovesList list;
+    chess_all_legal_moves(state, &list);
+    const ChessMove *pv_move = (ply < w->prev_pv_len) ? &w->prev_pv[ply] : NULL;
+    if (list.count > 0 && depth > 0 && ply < CHESS_SEARCH_MAX_PLY - 1) {
+        order_moves(eng, state, &list, pv_move, tt_hit ? &tt : NULL, ply);
+        if (frame_store_moves(w, f, &list)) {
+            f->alpha_orig = alpha;
+            f->best = -CHESS_SEARCH_MATE - 1;
+            f->best_i = 0;
+            return 0;
+        }
+    }
+    int leaf;
+    if (list.count == 0)
+        leaf = chess_is_king_in_check(state, state->side_to_move) ? -(CHESS_SEARCH_MATE - ply) : 0;
+    else
+        leaf = frame_eval(w, f);
+    TRACE_NODE(ply, (const ChessMove *)0, CHESS_TRACE_NO_CUTOFF, alpha, beta, leaf, list.count,
+               CHESS_TRACE_F_LEAF);
+    *value = leaf;
+    return 1;
+}
+
+static int finish_search(ChessEngine *eng, const ChessSearchFrame *f, int cutoff) {
+    ChessSearchWork *w = &eng->work;
+    const ChessMove *best_move = &w->moves[f->move_base + f->best_i];
+    TRACE_NODE(f->ply, best_move, cutoff, f->alpha_orig, f->beta, f->best, f->count, 0);
+    (void)cutoff;
+    int bound = (f->best <= f->alpha_orig) ? CHESS_TT_UPPER : (f->best >= f->beta) ? CHESS_TT_LOWER : CHESS_TT_EXACT;
+    chess_tt_store(&eng->tt, f->key, f->depth, score_to_tt(f->best, f->ply), bound,
+                   bound == CHESS_TT_UPPER ? NULL : best_move);
+    return f->best;
+}
+
+static int child_search(ChessEngine *eng, ChessSearchFrame *f, int score, int *value) {
+    ChessSearchWork *w = &eng->work;
+    int ply = f->ply;
+    const ChessMove *m = &w->moves[f->move_base + f->next];
+    if (score > f->best) {
+        f->best = score;
+        f->best_i = f->next;
+        if (score > f->alpha) {
+            f->alpha = score;
+            w->pv[ply][0] = *m;
+            memcpy(&w->pv[ply][1], w->pv[ply + 1], (size_t)w->pv_len[ply + 1] * sizeof(ChessMove));
+            w->pv_len[ply] = w->pv_len[ply + 1] + 1;
+        }
+    }
+    if (f->alpha >= f->beta) {
+        w->stats.beta_cutoffs++;
+        if (f->next == 0) w->stats.first_move_cutoffs++;
+        if (!is_capture(&f->state, m) && m->promote_to == CHESS_PROMOTE_NONE)
+            note_quiet_cutoff(eng, &f->state, m, f->depth, ply);
+        *value = finish_search(eng, f, f->next);
+        return 1;
+    }
+    f->next++;
+    return 0;
+}
+
+/*
+ * 运行帧栈直到根帧得出结果（写 *value，返回 1）或本片时间用完（返回 0，可再次调用原样继续）。
+ * 被中止时整栈立即退出，返回 1 且 *value 为 0，由调用方检查 w->aborted。
+ */
+static int frames_run(ChessEngine *eng, int *value) {
+    ChessSearchWork *w = &eng->work;
+    for (;;) {
+        ChessSearchFrame *f = &w->frames[w->top];
+        int v;
+        int resolved = 0;
+        if (f->phase == FRAME_ENTER) {
+            if (w->slice_deadline_us && game_clock_us() >= w->slice_deadline_us) return 0;
+            w->pv_len[f->ply] = 0;
+            resolved = (f->kind == FRAME_QUIESCE) ? enter_quiesce(eng, f, &v) : enter_search(eng, f, &v);
+            f->phase = FRAME_CHILD;
+            if (!resolved && f->count == 0) {
+                v = (f->kind == FRAME_QUIESCE) ? finish_quiesce(w, f, CHESS_TRACE_NO_CUTOFF) : f->best;
+                resolved = 1;
+            }
+        }
+        /* 逐层返回：子节点结果取反交给父帧，父帧未结束则压入下一个走法 */
+        while (resolved) {
+            if (w->aborted) {
+                w->top = w->base;
+                *value = 0;
+                return 1;
+            }
+            if (w->top == w->base) {
+                *value = v;
+                return 1;
+            }
+            f = &w->frames[--w->top];
+            resolved = (f->kind == FRAME_QUIESCE) ? child_quiesce(eng, f, -v, &v) : child_search(eng, f, -v, &v);
+            if (!resolved && f->next >= f->count) {
+                v = (f->kind == FRAME_QUIESCE) ? finish_quiesce(w, f, CHESS_TRACE_NO_CUTOFF)
+                                               : finish_search(eng, f, CHESS_TRACE_NO_CUTOFF);
+                resolved = 1;
+            }
+        }
+        push_child(w, f);
+    }
+}
+
+static void begin_search(ChessEngine *eng, const ChessSearchLimits *limits, uint32_t budget_us) {
+    ChessSearchWork *w = &eng->work;
+    w->limits = limits;
+    w->start_us = game_clock_us();
+    w->deadline_us = limits->movetime_ms ? w->start_us + (uint64_t)limits->movetime_ms * 1000u : 0;
+    w->slice_deadline_us = budget_us ? w->start_us + budget_us : 0;
+    chess_search_stats_clear(&w->stats);
+    w->poll_nodes = limits->poll_nodes ? limits->poll_nodes : CHESS_SEARCH_POLL_NODES;
+    w->next_poll = w->poll_nodes;
+    w->aborted = 0;
+    w->prev_pv_len = 0;
+}
+
+/* 结束时补上耗时，并累加到调用方提供的统计 */
+static void end_search(ChessEngine *eng) {
+    ChessSearchWork *w = &eng->work;
+    w->stats.elapsed_us = (uint32_t)(game_clock_us() - w->start_us);
+    chess_search_stats_finish(&w->stats);
+    ChessSearchStats *acc = w->limits->stats;
+    if (!acc) return;
+    acc->nodes += w->stats.nodes;
+    acc->qnodes += w->stats.qnodes;
+    acc->tt_hits += w->stats.tt_hits;
+    acc->beta_cutoffs += w->stats.beta_cutoffs;
+    acc->first_move_cutoffs += w->stats.first_move_cutoffs;
+    if (w->stats.depth > acc->depth) acc->depth = w->stats.depth;
+    acc->elapsed_us += w->stats.elapsed_us;
+    chess_search_stats_finish(acc);
+}
+
+/* 新的一次根搜索：杀手着法只对本局面有意义，清空；历史分减半保留趋势 */
+static void age_tables(ChessEngine *eng) {
+    memset(eng->killers, 0, sizeof(eng->killers));
+    for (int p = 0; p < CHESS_PIECE_CODES; p++)
+        for (int sq = 0; sq < 64; sq++)
+            eng->history[p][sq] >>= 1;
+}
+
+int chess_search_run(ChessEngine *eng, const ChessBoardState *state, const ChessSearchLimits *limits,
+                     ChessSearchResult *out) {
+    ChessSearchWork *w = &eng->work;
+    memset(out, 0, sizeof(*out));
+    ChessAllMovesList root;
+    chess_all_legal_moves(state, &root);
+    if (root.count == 0) return 0;
+
+    begin_search(eng, limits, 0);
+    age_tables(eng);
+    TRACE_RESET();
+    out->has_move = 1;
+    out->best = root.moves[0];
+    int max_depth = (limits->depth > 0 && limits->depth < CHESS_SEARCH_MAX_DEPTH) ? limits->depth : CHESS_SEARCH_MAX_DEPTH;
+
+    for (int depth = 1; depth <= max_depth; depth++) {
+        int score;
+        push_root(eng, state, depth, 0, -CHESS_SEARCH_MATE - 1, CHESS_SEARCH_MATE + 1);
+        frames_run(eng, &score);
+        /* 中止的迭代若已有 PV 首步（PV 着法最先搜），其结果不差于上一层，仍可采用 */
+        if (w->aborted && w->pv_len[0] == 0) break;
+        if (!w->aborted) w->stats.depth = depth;
+        if (w->pv_len[0] > 0) out->best = w->pv[0][0];
+        if (w->aborted) break;
+
+        ChessSearchInfo *info = &out->info;
+        uint64_t elapsed_us = game_clock_us() - w->start_us;
+        info->depth = depth;
+        info->score = score;
+        info->nodes = w->stats.nodes;
+        info->elapsed_ms = (uint32_t)(elapsed_us / 1000u);
+        info->nps = elapsed_us ? (uint32_t)((uint64_t)w->stats.nodes * 1000000u / elapsed_us) : 0;
+        info->pv_len = w->pv_len[0];
+        memcpy(info->pv, w->pv[0], (size_t)w->pv_len[0] * sizeof(ChessMove));
+        memcpy(w->prev_pv, w->pv[0], (size_t)w->pv_len[0] * sizeof(ChessMove));
+        w->prev_pv_len = w->pv_len[0];
+        if (limits->on_info) limits->on_info(info, limits->info_user);
+
+        /* 已找到杀棋则无需加深 */
+        if (score > CHESS_SEARCH_MATE_BOUND || score < -CHESS_SEARCH_MATE_BOUND) break;
+    }
+    end_search(eng);
+    out->stats = w->stats;
+    return 1;
+}
+
+/* ---------- MultiPV ---------- */
+
+void chess_multipv_init(ChessEngine *eng, ChessMultiPv *mp, const ChessBoardState *root,
+                        const ChessAllMovesList *moves, int depth, int k, int margin) {
+    mp->list = *moves;
+    ChessTTEntry tt;
+    int tt_hit = chess_tt_probe(&eng->tt, chess_zobrist_hash(root), &tt);
+    age_tables(eng);
+    order_moves(eng, root, &mp->list, NULL, tt_hit ? &tt : NULL, 0);
+    mp->depth = depth;
+    mp->k = (k < 1) ? 1 : (k > CHESS_MULTIPV_MAX) ? CHESS_MULTIPV_MAX : k;
+    mp->margin = margin;
+    mp->next = 0;
+    mp->stage = 0;
+    mp->count = 0;
+}
+
+/* 新着法须达到的最低分 */
+static int multipv_threshold(const ChessMultiPv *mp) {
+    int t = mp->top[0].score - mp->margin;
+    if (mp->count >= mp->k && mp->top[mp->k - 1].score + 1 > t) t = mp->top[mp->k - 1].score + 1;
+    return t;
+}
+
+/* 按分数降序插入，超出 k 个或低于新的最佳 - margin 的尾部丢弃 */
+static void multipv_insert(ChessMultiPv *mp, const ChessMove *m, int score) {
+    int i = (mp->count < mp->k) ? mp->count++ : mp->k - 1;
+    while (i > 0 && mp->top[i - 1].score < score) {
+        mp->top[i] = mp->top[i - 1];
+        i--;
+    }
+    mp->top[i].move = *m;
+    mp->top[i].score = score;
+    while (mp->count > 1 && mp->top[mp->count - 1].score < mp->top[0].score - mp->margin)
+        mp->count--;
+}
+
+enum { MPV_IDLE, MPV_FULL, MPV_PROBE, MPV_RESEARCH };
+
+/* 为当前根走法的当前阶段压入根帧：全窗口；零窗口 (t-1, t)；fail high 后在 (t-1, +inf) 上重搜精确分 */
+static void multipv_push(ChessEngine *eng, ChessMultiPv *mp, const ChessBoardState *root) {
+    ChessBoardState next = *root;
+    chess_do_move(&next, &mp->list.moves[mp->next]);
+    int t = mp->threshold;
+    if (mp->stage == MPV_FULL)
+        push_root(eng, &next, mp->depth - 1, 1, -CHESS_SEARCH_MATE - 1, CHESS_SEARCH_MATE + 1);
+    else if (mp->stage == MPV_PROBE)
+        push_root(eng, &next, mp->depth - 1, 1, -t, -(t - 1));
+    else
+        push_root(eng, &next, mp->depth - 1, 1, -CHESS_SEARCH_MATE - 1, -(t - 1));
+    eng->work.owner = mp;
+}
+
+int chess_multipv_step(ChessEngine *eng, ChessMultiPv *mp, const ChessBoardState *root,
+                       const ChessSearchLimits *limits, uint32_t budget_us) {
+    ChessSearchWork *w = &eng->work;
+    begin_search(eng, limits, budget_us);
+    /* 帧栈里暂停着的正是本任务当前阶段时接着算，否则该阶段从头压栈 */
+    int resume = (mp->stage != MPV_IDLE && w->owner == mp);
+    int paused = 0;
+    while (mp->next < mp->list.count) {
+        if (mp->stage == MPV_IDLE) {
+            mp->stage = (mp->count == 0) ? MPV_FULL : MPV_PROBE;
+            if (mp->stage == MPV_PROBE) mp->threshold = multipv_threshold(mp);
+        }
+        if (!resume) multipv_push(eng, mp, root);
+        resume = 0;
+        int v;
+        if (!frames_run(eng, &v)) { paused = 1; break; }
+        w->owner = NULL;
+        if (w->aborted) break;
+        int score = -v;
+        if (mp->stage == MPV_PROBE && score >= mp->threshold) {
+            mp->stage = MPV_RESEARCH;
+            continue;
+        }
+        if (mp->stage == MPV_FULL || score >= mp->threshold)
+            multipv_insert(mp, &mp->list.moves[mp->next], score);
+        mp->next++;
+        mp->stage = MPV_IDLE;
+    }
+    int done = !paused && !w->aborted;
+    if (done) w->stats.depth = mp->depth;
+    end_search(eng);
+    return done;
+}
+
+int chess_multipv_run(ChessEngine *eng, ChessMultiPv *mp, const ChessBoardState *root,
+                      const ChessSearchLimits *limits) {
+    return chess_multipv_step(eng, mp, root, limits, 0);
+}
@@ -0,0 +1,178 @@
+/**
+ * @file chess_search.h
+ * @brief 限时/限节点/限深度的迭代加深 Negamax + Alpha-Beta + 静态搜索（供 UCI 与 AI 使用）
+ *
+ * 搜索不用 C 递归：每层一个显式帧（ChessSearchFrame），走法放在共用的着法池里，
+ * 因此可在任意节点之间暂停并原样继续（chess_multipv_step），主循环可把搜索切成小片与界面交替运行。
+ */
+
+#ifndef PICO_CODE_CHESS_SEARCH_H
+#define PICO_CODE_CHESS_SEARCH_H
+
+#include <stdint.h>
+#include "chess_state.h"
+#include "chess_move.h"
+#if CHESS_NNUE
+#include "chess_nnue.h"
+#endif
+
+#define CHESS_SEARCH_MAX_PLY   32
+#define CHESS_SEARCH_MAX_DEPTH 16
+#define CHESS_SEARCH_MATE      30000
+/* |score| 超过此值即为杀棋分，距离 = CHESS_SEARCH_MATE - |score| 个半回合 */
+#define CHESS_SEARCH_MATE_BOUND (CHESS_SEARCH_MATE - CHESS_SEARCH_MAX_PLY)
+/* 每搜索这么多节点检查一次时间/节点/中止标志 */
+#define CHESS_SEARCH_POLL_NODES 512
+/* MultiPV 最多保留的精确分着法数 */
+#define CHESS_MULTIPV_MAX 8
+/* 各层帧共用的着法池（16 字节/步）；放不下的节点按叶子处理 */
+#ifndef CHESS_SEARCH_MOVE_POOL
+#define CHESS_SEARCH_MOVE_POOL 768
+#endif
+
+/* 引擎上下文（chess_engine.h）：置换表与搜索工作区都在其中，各函数只使用传入的引擎 */
+typedef struct ChessEngine ChessEngine;
+
+/** 搜索统计：每次搜索都会填写，用于在真机上发现性能退化 */
+typedef struct {
+    uint32_t nodes;                 /* 全部节点（含静态搜索） */
+    uint32_t qnodes;                /* 其中静态搜索节点 */
+    uint32_t tt_hits;               /* 置换表探测命中次数 */
+    uint32_t beta_cutoffs;          /* alpha >= beta 剪枝次数 */
+    uint32_t first_move_cutoffs;    /* 其中由第一个着法产生的剪枝（排序质量） */
+    int depth;                      /* 完成的深度 */
+    uint32_t elapsed_us;
+    uint32_t nps;
+} ChessSearchStats;
+
+/** 每完成一层迭代的汇报（UCI info 行） */
+typedef struct {
+    int depth;
+    int score;              /* 厘兵，行棋方视角 */
+    uint32_t nodes;
+    uint32_t elapsed_ms;
+    uint32_t nps;
+    ChessMove pv[CHESS_SEARCH_MAX_PLY];
+    int pv_len;
+} ChessSearchInfo;
+
+/** 搜索限制：各项为 0 表示不限，全部为 0 时只受 CHESS_SEARCH_MAX_DEPTH 限制（外部中止见 ChessEngine.abort） */
+typedef struct {
+    int depth;
+    uint32_t movetime_ms;
+    uint32_t nodes;
+    int (*poll)(void *user);            /* 每 poll_nodes 个节点调用，返回非 0 则中止 */
+    void *poll_user;
+    uint32_t poll_nodes;                /* 0 = CHESS_SEARCH_POLL_NODES；后台思考用 1 以便毫秒级中断 */
+    int no_quiesce;                     /* 1 = 叶子直接用子力评估（Medium 固定层数搜索） */
+    ChessSearchStats *stats;            /* 非 NULL 时把本次搜索统计累加进去（多次搜索合计） */
+    void (*on_info)(const ChessSearchInfo *info, void *user);
+    void *info_user;
+} ChessSearchLimits;
+
+/** 显式栈的一层：局面、窗口与本层走法在着法池中的位置；杀棋求解也用它（depth 为剩余步数） */
+typedef struct {
+    ChessBoardState state;
+    uint64_t key;
+    int alpha;
+    int beta;
+    int alpha_orig;         /* 进入节点时的 alpha（置换表界类型与跟踪用） */
+    int best;
+    uint16_t move_base;     /* 本层走法在 moves[] 中的起点 */
+    uint8_t count;          /* 本层待搜走法数 */
+    uint8_t next;           /* 正在搜的走法序号 */
+    uint8_t best_i;
+    uint8_t nmoves;         /* 合法走法总数（跟踪用） */
+    int8_t depth;
+    uint8_t ply;
+    uint8_t kind;
+    uint8_t phase;
+} ChessSearchFrame;
+
+/** 单次搜索的工作区（ChessEngine.work），由 chess_search.c 与 chess_mate.c 使用 */
+typedef struct {
+    const ChessSearchLimits *limits;
+    uint64_t start_us;
+    uint64_t deadline_us;               /* 0 = 不限时 */
+    ChessSearchStats stats;
+    uint32_t next_poll;
+    uint32_t poll_nodes;
+    int aborted;
+    ChessMove pv[CHESS_SEARCH_MAX_PLY][CHESS_SEARCH_MAX_PLY];   /* 三角 PV 表 */
+    int pv_len[CHESS_SEARCH_MAX_PLY];
+    ChessMove prev_pv[CHESS_SEARCH_MAX_PLY];                    /* 上一层迭代的 PV */
+    int prev_pv_len;
+    ChessSearchFrame frames[CHESS_SEARCH_MAX_PLY];              /* 按 ply 索引 */
+    ChessMove moves[CHESS_SEARCH_MOVE_POOL];
+    int base;                           /* 本次根帧的 ply */
+    int top;                            /* 当前帧的 ply */
+    uint64_t slice_deadline_us;         /* 本片结束时刻，0 = 不分片 */
+    const void *owner;                  /* 帧栈里暂停着的是谁的搜索（可续算的任务据此判断能否接着算） */
+#if CHESS_NNUE
+    ChessNnueAcc acc[CHESS_SEARCH_MAX_PLY];     /* 按 ply：压入子帧时由父层增量更新 */
+#endif
+} ChessSearchWork;
+
+typedef struct {
+    int has_move;
+    ChessMove best;
+    ChessSearchInfo info;   /* 最后一层完整迭代 */
+    ChessSearchStats stats; /* 本次搜索全部统计（含被中止的最后一层） */
+} ChessSearchResult;
+
+void chess_search_limits_init(ChessSearchLimits *l);
+
+void chess_search_stats_clear(ChessSearchStats *st);
+
+/** 由 nodes 与 elapsed_us 计算 nps */
+void chess_search_stats_finish(ChessSearchStats *st);
+
+/** 统计写成一行文本（不含换行），返回长度 */
+int chess_search_stats_format(const ChessSearchStats *st, char *buf, int size);
+
+/** 搜索当前行棋方的最佳着法；无合法走法返回 0 */
+int chess_search_run(ChessEngine *eng, const ChessBoardState *state, const ChessSearchLimits *limits,
+                     ChessSearchResult *out);
+
+
+/** MultiPV 的一个根着法及其精确分（根行棋方视角） */
+typedef struct {
+    ChessMove move;
+    int score;
+} ChessRootMove;
+
+/**
+ * MultiPV 根搜索，可分片续算：只有前 k 名保留精确分，其余根着法先以零窗口检验能否达到门槛
+ * max(第 k 名 + 1, 最佳 - margin)，达不到即丢弃，不做全窗口搜索。
+ */
+typedef struct {
+    ChessAllMovesList list;                 /* 根走法（init 时已排序） */
+    int depth;
+    int k;
+    int margin;                             /* 厘兵；低于最佳超过 margin 的着法不保留 */
+    int next;                               /* 下一个待搜的根走法 */
+    int stage;                              /* 该根走法进行到：0 未开始 / 全窗口 / 零窗口 / 重搜 */
+    int threshold;                          /* 零窗口检验的门槛 */
+    ChessRootMove top[CHESS_MULTIPV_MAX];   /* 按分数降序，共 count 个 */
+    int count;
+} ChessMultiPv;
+
+/**
+ * 以 moves（root 的全部合法走法）初始化；走法按 TT 着法、吃子价值稳定排序，
+ * 同分着法保持 moves 中的先后（调用方可先打乱以获得随机性）。k 超过 CHESS_MULTIPV_MAX 时截断。
+ */
+void chess_multipv_init(ChessEngine *eng, ChessMultiPv *mp, const ChessBoardState *root,
+                        const ChessAllMovesList *moves, int depth, int k, int margin);
+
+/** 从 mp->next 继续搜索根走法：全部完成返回 1，被 limits 中止返回 0（已完成的着法保留，可再次调用） */
+int chess_multipv_run(ChessEngine *eng, ChessMultiPv *mp, const ChessBoardState *root,
+                      const ChessSearchLimits *limits);
+
+/**
+ * 同 chess_multipv_run，但至多运行约 budget_us 微秒（超出量为单个节点的耗时）后暂停并返回 0；
+ * 再次调用时从暂停的节点原样继续。其间若引擎跑过别的搜索，当前根走法从头重算。
+ */
+int chess_multipv_step(ChessEngine *eng, ChessMultiPv *mp, const ChessBoardState *root,
+                       const ChessSearchLimits *limits, uint32_t budget_us);
+
+#endif /* PICO_CODE_CHESS_SEARCH_H */
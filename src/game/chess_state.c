@@ -28,3 +28,13 @@ int chess_state_is_empty(const ChessBoardState *b, int r, int c) {
 int chess_state_in_bounds(int r, int c) {
     return r >= 0 && r < 8 && c >= 0 && c < 8;
 }
+
+int chess_state_equal(const ChessBoardState *a, const ChessBoardState *b) {
+    for (int r = 0; r < 8; r++)
+        for (int c = 0; c < 8; c++)
+            if (a->board[r][c] != b->board[r][c]) return 0;
+    return a->side_to_move == b->side_to_move &&
+           a->castling[0][0] == b->castling[0][0] && a->castling[0][1] == b->castling[0][1] &&
+           a->castling[1][0] == b->castling[1][0] && a->castling[1][1] == b->castling[1][1] &&
+           a->ep_col == b->ep_col;
+}
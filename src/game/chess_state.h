@@ -22,4 +22,7 @@ int8_t chess_state_at(const ChessBoardState *b, int r, int c);
 int chess_state_is_empty(const ChessBoardState *b, int r, int c);
 int chess_state_in_bounds(int r, int c);
 
+/** 两局面是否完全相同（棋盘、行棋方、易位资格、吃过路兵列） */
+int chess_state_equal(const ChessBoardState *a, const ChessBoardState *b);
+
 #endif /* PICO_CODE_CHESS_STATE_H */
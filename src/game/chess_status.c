@@ -0,0 +1,56 @@
+/**
+ * @file chess_status.c
+ */
+
+#include <stddef.h>
+#include "chess_types.h"
+#include "chess_state.h"
+#include "chess_move.h"
+#include "chess_check.h"
+#include "chess_legal.h"
+#include "chess_status.h"
+
+void chess_status_build(const ChessBoardState *b, ChessTurnStatus *st) {
+    ChessMoveList piece_list;
+    chess_all_moves_clear(&st->moves);
+    for (int r = 0; r < 8; r++) {
+        for (int c = 0; c < 8; c++) {
+            int sq = r * 8 + c;
+            st->from_start[sq] = (uint8_t)st->moves.count;
+            st->from_count[sq] = 0;
+            if (b->board[r][c] == CHESS_EMPTY || !chess_is_own_piece(b->board[r][c], b->side_to_move))
+                continue;
+            chess_legal_moves_from(b, r, c, &piece_list);
+            for (int i = 0; i < piece_list.count; i++)
+                chess_all_moves_add(&st->moves, &piece_list.moves[i]);
+            st->from_count[sq] = (uint8_t)(st->moves.count - st->from_start[sq]);
+        }
+    }
+    st->in_check = chess_is_king_in_check(b, b->side_to_move);
+    if (st->moves.count > 0)
+        st->result = 0;
+    else if (st->in_check)
+        st->result = (b->side_to_move == 0) ? 1 : 2;
+    else
+        st->result = 3;
+}
+
+const ChessMove *chess_status_moves_from(const ChessTurnStatus *st, int r, int c, int *count) {
+    if (!chess_state_in_bounds(r, c)) {
+        *count = 0;
+        return st->moves.moves;
+    }
+    int sq = r * 8 + c;
+    *count = st->from_count[sq];
+    return &st->moves.moves[st->from_start[sq]];
+}
+
+const ChessMove *chess_status_find_move(const ChessTurnStatus *st, int from_r, int from_c,
+                                        int to_r, int to_c) {
+    int n;
+    const ChessMove *list = chess_status_moves_from(st, from_r, from_c, &n);
+    for (int i = 0; i < n; i++)
+        if (list[i].to_r == to_r && list[i].to_c == to_c)
+            return &list[i];
+    return NULL;
+}
@@ -0,0 +1,32 @@
+/**
+ * @file chess_status.h
+ * @brief 每回合状态缓存：终局结果、将军标志、按源格索引的全部合法走法（走子后构建一次）
+ */
+
+#ifndef PICO_CODE_CHESS_STATUS_H
+#define PICO_CODE_CHESS_STATUS_H
+
+#include <stdint.h>
+#include "chess_state.h"
+#include "chess_move.h"
+
+/** 回合状态缓存：走法按源格连续存放，from_start/from_count 以 r*8+c 索引 */
+typedef struct {
+    int result;                 /* 同 chess_get_game_result：0 进行中 1 白胜 2 黑胜 3 逼和 */
+    int in_check;               /* 当前行棋方是否被将军 */
+    ChessAllMovesList moves;    /* 当前行棋方全部合法走法 */
+    uint8_t from_start[64];
+    uint8_t from_count[64];
+} ChessTurnStatus;
+
+/** 对当前局面做一次完整合法走法生成并填充缓存（每步棋后调用一次） */
+void chess_status_build(const ChessBoardState *b, ChessTurnStatus *st);
+
+/** 某格出发的合法走法（指向缓存内部），*count 为个数；越界或无子返回 count=0 */
+const ChessMove *chess_status_moves_from(const ChessTurnStatus *st, int r, int c, int *count);
+
+/** 在某格出发的走法中查找目标格 (to_r,to_c)，找不到返回 NULL */
+const ChessMove *chess_status_find_move(const ChessTurnStatus *st, int from_r, int from_c,
+                                        int to_r, int to_c);
+
+#endif /* PICO_CODE_CHESS_STATUS_H */
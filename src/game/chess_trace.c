@@ -0,0 +1,105 @@
+/**
+ * @file chess_trace.c
+ */
+
+#include "chess_trace.h"
+
+#if CHESS_SEARCH_TRACE
+
+static ChessTraceRecord s_ring[CHESS_TRACE_CAPACITY];
+static uint32_t s_total;
+
+void chess_trace_reset(void) {
+    s_total = 0;
+}
+
+void chess_trace_record(int ply, int from_sq, int to_sq, int cutoff, int alpha, int beta,
+                        int score, int nmoves, int flags) {
+    ChessTraceRecord *r = &s_ring[s_total % CHESS_TRACE_CAPACITY];
+    r->ply = (uint8_t)ply;
+    r->from_sq = (uint8_t)from_sq;
+    r->to_sq = (uint8_t)to_sq;
+    r->cutoff = (uint8_t)cutoff;
+    r->alpha = (int16_t)alpha;
+    r->beta = (int16_t)beta;
+    r->score = (int16_t)score;
+    r->nmoves = (uint8_t)nmoves;
+    r->flags = (uint8_t)flags;
+    s_total++;
+}
+
+uint32_t chess_trace_total(void) {
+    return s_total;
+}
+
+/* 按时间顺序遍历环形缓冲，逐条序列化为 12 字节小端 */
+static void encode(const ChessTraceRecord *r, uint8_t out[12]) {
+    out[0] = r->ply;
+    out[1] = r->from_sq;
+    out[2] = r->to_sq;
+    out[3] = r->cutoff;
+    out[4] = (uint8_t)(r->alpha & 0xFF);  out[5] = (uint8_t)((uint16_t)r->alpha >> 8);
+    out[6] = (uint8_t)(r->beta & 0xFF);   out[7] = (uint8_t)((uint16_t)r->beta >> 8);
+    out[8] = (uint8_t)(r->score & 0xFF);  out[9] = (uint8_t)((uint16_t)r->score >> 8);
+    out[10] = r->nmoves;
+    out[11] = r->flags;
+}
+
+static uint32_t first_index(uint32_t *count) {
+    *count = s_total < CHESS_TRACE_CAPACITY ? s_total : CHESS_TRACE_CAPACITY;
+    return s_total - *count;
+}
+
+int chess_trace_write(FILE *f) {
+    uint32_t count;
+    uint32_t start = first_index(&count);
+    uint8_t hdr[8] = { 'C', 'T', 'R', '1',
+                       (uint8_t)count, (uint8_t)(count >> 8), (uint8_t)(count >> 16), (uint8_t)(count >> 24) };
+    if (fwrite(hdr, 1, sizeof(hdr), f) != sizeof(hdr)) return 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t buf[12];
+        encode(&s_ring[(start + i) % CHESS_TRACE_CAPACITY], buf);
+        if (fwrite(buf, 1, sizeof(buf), f) != sizeof(buf)) return 0;
+    }
+    return 1;
+}
+
+void chess_trace_dump_hex(void) {
+    uint32_t count;
+    uint32_t start = first_index(&count);
+    printf("trace begin %lu %lu\n", (unsigned long)count, (unsigned long)s_total);
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t buf[12];
+        encode(&s_ring[(start + i) % CHESS_TRACE_CAPACITY], buf);
+        printf("trace ");
+        for (int k = 0; k < 12; k++) printf("%02x", buf[k]);
+        printf("\n");
+    }
+    printf("trace end\n");
+    fflush(stdout);
+}
+
+#else
+
+void chess_trace_reset(void) {}
+
+void chess_trace_record(int ply, int from_sq, int to_sq, int cutoff, int alpha, int beta,
+                        int score, int nmoves, int flags) {
+    (void)ply; (void)from_sq; (void)to_sq; (void)cutoff; (void)alpha; (void)beta;
+    (void)score; (void)nmoves; (void)flags;
+}
+
+uint32_t chess_trace_total(void) {
+    return 0;
+}
+
+int chess_trace_write(FILE *f) {
+    (void)f;
+    return 0;
+}
+
+void chess_trace_dump_hex(void) {
+    printf("info string trace disabled (build with CHESS_SEARCH_TRACE=1)\n");
+}
+
+#endif
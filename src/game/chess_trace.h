@@ -0,0 +1,57 @@
+/**
+ * @file chess_trace.h
+ * @brief 搜索树跟踪（编译期开关 CHESS_SEARCH_TRACE=1）：每个节点退出时写一条 12 字节定长记录到环形缓冲，
+ *        可经 USB 以十六进制输出或在主机写成二进制文件，由 tools/chess_trace/trace_summary.py 汇总。
+ *
+ * 未开启时 chess_search.c 中的 TRACE_NODE 展开为空，不产生任何代码或数据。
+ */
+
+#ifndef PICO_CODE_CHESS_TRACE_H
+#define PICO_CODE_CHESS_TRACE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef CHESS_SEARCH_TRACE
+#define CHESS_SEARCH_TRACE 0
+#endif
+
+/* 设备上 1024 条 = 12KB；主机可加大 */
+#ifndef CHESS_TRACE_CAPACITY
+#define CHESS_TRACE_CAPACITY 1024
+#endif
+
+#define CHESS_TRACE_NO_CUTOFF 0xFF
+#define CHESS_TRACE_NO_MOVE   0xFF
+
+#define CHESS_TRACE_F_QUIESCE 0x01   /* 静态搜索节点 */
+#define CHESS_TRACE_F_TT      0x02   /* 置换表直接返回 */
+#define CHESS_TRACE_F_LEAF    0x04   /* 叶子（评估/终局） */
+
+/** 定长记录（小端，12 字节）；move 为本节点最佳或剪枝着法，格号 r*8+c */
+typedef struct {
+    uint8_t ply;
+    uint8_t from_sq;
+    uint8_t to_sq;
+    uint8_t cutoff;     /* 产生剪枝的着法序号（0 = 首个着法），无剪枝为 0xFF */
+    int16_t alpha;      /* 进入节点时的窗口 */
+    int16_t beta;
+    int16_t score;
+    uint8_t nmoves;     /* 本节点合法走法数 */
+    uint8_t flags;
+} ChessTraceRecord;
+
+void chess_trace_reset(void);
+void chess_trace_record(int ply, int from_sq, int to_sq, int cutoff, int alpha, int beta,
+                        int score, int nmoves, int flags);
+
+/** 自上次 reset 以来写入的总条数（超过容量时旧记录被覆盖） */
+uint32_t chess_trace_total(void);
+
+/** 二进制输出：8 字节头 "CTR1" + 小端条数，随后按时间顺序的记录 */
+int chess_trace_write(FILE *f);
+
+/** 十六进制输出到 stdout，每行 "trace <24 位 hex>"，以 "trace end" 结束（供 USB 串口） */
+void chess_trace_dump_hex(void);
+
+#endif /* PICO_CODE_CHESS_TRACE_H */
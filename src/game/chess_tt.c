@@ -0,0 +1,40 @@
+/**
+ * @file chess_tt.c
+ */
+
+#include <string.h>
+#include "chess_move.h"
+#include "chess_tt.h"
+
+void chess_tt_clear(ChessTT *tt) {
+    memset(tt->entries, 0, sizeof(tt->entries));
+}
+
+int chess_tt_probe(const ChessTT *tt, uint64_t key, ChessTTEntry *out) {
+    const ChessTTEntry *e = &tt->entries[key & (CHESS_TT_SIZE - 1)];
+    if (e->bound == CHESS_TT_NONE || e->check != (uint32_t)(key >> 32)) return 0;
+    *out = *e;
+    return 1;
+}
+
+void chess_tt_store(ChessTT *tt, uint64_t key, int depth, int score, int bound, const ChessMove *best) {
+    ChessTTEntry *e = &tt->entries[key & (CHESS_TT_SIZE - 1)];
+    uint32_t check = (uint32_t)(key >> 32);
+    int same = (e->bound != CHESS_TT_NONE && e->check == check);
+    if (same && e->depth > depth) return;
+    e->check = check;
+    e->score = (int16_t)score;
+    e->depth = (int8_t)depth;
+    e->bound = (uint8_t)bound;
+    if (best) {
+        e->from_sq = (uint8_t)(best->from_r * 8 + best->from_c);
+        e->to_sq = (uint8_t)(best->to_r * 8 + best->to_c);
+    } else if (!same) {
+        e->from_sq = e->to_sq = 0xFF;
+    }
+}
+
+int chess_tt_move_is(const ChessTTEntry *e, const ChessMove *m) {
+    return e->from_sq == (uint8_t)(m->from_r * 8 + m->from_c) &&
+           e->to_sq == (uint8_t)(m->to_r * 8 + m->to_c);
+}
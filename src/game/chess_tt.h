@@ -0,0 +1,52 @@
+/**
+ * @file chess_tt.h
+ * @brief 置换表：按 Zobrist 哈希存搜索深度、分数、界类型与最佳着法（12 字节/项）
+ *
+ * 表本身由调用方持有（通常在 ChessEngine 中），各函数只操作传入的表，互不共享。
+ */
+
+#ifndef PICO_CODE_CHESS_TT_H
+#define PICO_CODE_CHESS_TT_H
+
+#include <stdint.h>
+#include "chess_move.h"
+
+/* 2^11 项 × 12 字节 = 24KB；主机上可用 -DCHESS_TT_BITS=20 加大 */
+#ifndef CHESS_TT_BITS
+#define CHESS_TT_BITS 11
+#endif
+#define CHESS_TT_SIZE (1u << CHESS_TT_BITS)
+
+enum {
+    CHESS_TT_NONE = 0,
+    CHESS_TT_EXACT,
+    CHESS_TT_LOWER,     /* score 为下界（fail-high） */
+    CHESS_TT_UPPER      /* score 为上界（fail-low） */
+};
+
+typedef struct {
+    uint32_t check;     /* 哈希高 32 位，用于校验 */
+    int16_t score;      /* 杀棋分已换算为相对本节点 */
+    int8_t depth;
+    uint8_t bound;
+    uint8_t from_sq;    /* r*8+c；无着法时为 0xFF */
+    uint8_t to_sq;
+    uint8_t pad[2];
+} ChessTTEntry;
+
+typedef struct {
+    ChessTTEntry entries[CHESS_TT_SIZE];
+} ChessTT;
+
+void chess_tt_clear(ChessTT *tt);
+
+/** 命中返回 1 并写入 *out */
+int chess_tt_probe(const ChessTT *tt, uint64_t key, ChessTTEntry *out);
+
+/** 写入：同一局面深度不低于旧项、或不同局面时覆盖；best 可为 NULL */
+void chess_tt_store(ChessTT *tt, uint64_t key, int depth, int score, int bound, const ChessMove *best);
+
+/** 表项记录的最佳着法是否为 m */
+int chess_tt_move_is(const ChessTTEntry *e, const ChessMove *m);
+
+#endif /* PICO_CODE_CHESS_TT_H */
@@ -4,40 +4,34 @@
 
 #include "chess_types.h"
 
+#define BP CHESS_PIECE(CHESS_COLOR_BLACK, CHESS_PIECE_PAWN)
+#define BN CHESS_PIECE(CHESS_COLOR_BLACK, CHESS_PIECE_KNIGHT)
+#define BB CHESS_PIECE(CHESS_COLOR_BLACK, CHESS_PIECE_BISHOP)
+#define BR CHESS_PIECE(CHESS_COLOR_BLACK, CHESS_PIECE_ROOK)
+#define BQ CHESS_PIECE(CHESS_COLOR_BLACK, CHESS_PIECE_QUEEN)
+#define BK CHESS_PIECE(CHESS_COLOR_BLACK, CHESS_PIECE_KING)
+#define WP CHESS_PIECE(CHESS_COLOR_WHITE, CHESS_PIECE_PAWN)
+#define WN CHESS_PIECE(CHESS_COLOR_WHITE, CHESS_PIECE_KNIGHT)
+#define WB CHESS_PIECE(CHESS_COLOR_WHITE, CHESS_PIECE_BISHOP)
+#define WR CHESS_PIECE(CHESS_COLOR_WHITE, CHESS_PIECE_ROOK)
+#define WQ CHESS_PIECE(CHESS_COLOR_WHITE, CHESS_PIECE_QUEEN)
+#define WK CHESS_PIECE(CHESS_COLOR_WHITE, CHESS_PIECE_KING)
+#define __ CHESS_EMPTY
+
 const int8_t CHESS_INITIAL_BOARD[8][8] = {
-    { 5,  2,  0,  4,  1,  0,  2,  5 },  /* 黑车马象后王象马车 */
-    { 3,  3,  3,  3,  3,  3,  3,  3 },  /* 黑兵 */
-    { -1, -1, -1, -1, -1, -1, -1, -1 },
-    { -1, -1, -1, -1, -1, -1, -1, -1 },
-    { -1, -1, -1, -1, -1, -1, -1, -1 },
-    { -1, -1, -1, -1, -1, -1, -1, -1 },
-    { 9,  9,  9,  9,  9,  9,  9,  9 },  /* 白兵 */
-    { 11, 8,  6,  10, 7,  6,  8,  11 }, /* 白车马象后王象马车 */
+    { BR, BN, BB, BQ, BK, BB, BN, BR },  /* 黑车马象后王象马车 */
+    { BP, BP, BP, BP, BP, BP, BP, BP },  /* 黑兵 */
+    { __, __, __, __, __, __, __, __ },
+    { __, __, __, __, __, __, __, __ },
+    { __, __, __, __, __, __, __, __ },
+    { __, __, __, __, __, __, __, __ },
+    { WP, WP, WP, WP, WP, WP, WP, WP },  /* 白兵 */
+    { WR, WN, WB, WQ, WK, WB, WN, WR },  /* 白车马象后王象马车 */
 };
 
-static const ChessPieceType s_index_to_type[] = {
-    CHESS_PIECE_BISHOP, CHESS_PIECE_KING, CHESS_PIECE_KNIGHT, CHESS_PIECE_PAWN,
-    CHESS_PIECE_QUEEN, CHESS_PIECE_ROOK,
-    CHESS_PIECE_BISHOP, CHESS_PIECE_KING, CHESS_PIECE_KNIGHT, CHESS_PIECE_PAWN,
-    CHESS_PIECE_QUEEN, CHESS_PIECE_ROOK
+/* 精灵顺序：黑象王马兵后车 0..5，白 6..11 */
+const int8_t CHESS_PIECE_SPRITE[CHESS_PIECE_CODES] = {
+    [BB] = 0, [BK] = 1, [BN] = 2, [BP] = 3, [BQ] = 4, [BR] = 5,
+    [WB] = 6, [WK] = 7, [WN] = 8, [WP] = 9, [WQ] = 10, [WR] = 11,
+    [0] = -1, [7] = -1, [8] = -1, [15] = -1,
 };
-
-ChessPieceType chess_piece_index_to_type(int8_t index) {
-    if (index < 0 || index > 11) return CHESS_PIECE_PAWN;
-    return s_index_to_type[index];
-}
-
-ChessPieceColor chess_piece_index_to_color(int8_t index) {
-    if (index < 0 || index > 11) return CHESS_COLOR_BLACK;
-    return (ChessPieceColor)(index < 6 ? 0 : 1);
-}
-
-int chess_is_own_piece(int8_t index, int side) {
-    if (index < 0) return 0;
-    return (side == 0 && index < 6) || (side == 1 && index >= 6);
-}
-
-int chess_is_opponent_piece(int8_t index, int side) {
-    if (index < 0) return 0;
-    return (side == 0 && index >= 6) || (side == 1 && index < 6);
-}
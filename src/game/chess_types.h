@@ -1,6 +1,8 @@
 /**
  * @file chess_types.h
- * @brief 棋子类型、颜色、常量与索引映射（与 demo types.hpp 一致）
+ * @brief 棋子编码、颜色、常量：棋子为位域（bit0-2 类型，bit3 颜色，0 为空），类型/颜色判断为头文件内联掩码
+ *
+ * 精灵图（chess_pieces_small.h）仍按 demo 顺序 0..11 排列，仅绘制时经 chess_piece_sprite() 查表换算。
  */
 
 #ifndef PICO_CODE_CHESS_TYPES_H
@@ -8,38 +10,58 @@
 
 #include <stdint.h>
 
-/* 棋子类型：用于走法生成 */
+/* 棋子类型：编码的低 3 位，0 保留给空格 */
 typedef enum {
-    CHESS_PIECE_KING = 0,
-    CHESS_PIECE_QUEEN,
-    CHESS_PIECE_ROOK,
-    CHESS_PIECE_BISHOP,
+    CHESS_PIECE_PAWN = 1,
     CHESS_PIECE_KNIGHT,
-    CHESS_PIECE_PAWN
+    CHESS_PIECE_BISHOP,
+    CHESS_PIECE_ROOK,
+    CHESS_PIECE_QUEEN,
+    CHESS_PIECE_KING
 } ChessPieceType;
 
-/* 颜色：0=黑 1=白 */
+/* 颜色：0=黑 1=白（即编码的 bit3） */
 typedef enum {
     CHESS_COLOR_BLACK = 0,
     CHESS_COLOR_WHITE = 1
 } ChessPieceColor;
 
-/* 棋盘格：棋子索引 0..11（与 chess_pieces 一致），-1 为空 */
-#define CHESS_EMPTY ((int8_t)(-1))
+#define CHESS_PIECE_TYPE_MASK  0x07
+#define CHESS_PIECE_COLOR_SHIFT 3
+#define CHESS_PIECE_CODES      16   /* 编码取值范围 0..15，可直接作数组下标 */
+
+/* 由颜色与类型组成棋子编码 */
+#define CHESS_PIECE(color, type) ((int8_t)(((color) << CHESS_PIECE_COLOR_SHIFT) | (type)))
+
+/* 棋盘格：棋子编码，0 为空 */
+#define CHESS_EMPTY ((int8_t)0)
 
-/* 开局棋盘（行 0=黑方底线，行 7=白方底线；索引同 chess_pieces.h） */
+/* 开局棋盘（行 0=黑方底线，行 7=白方底线） */
 extern const int8_t CHESS_INITIAL_BOARD[8][8];
 
-/* 棋子索引 → 类型（0→Bishop, 1→King, 2→Knight, 3→Pawn, 4→Queen, 5→Rook；6..11 同序） */
-ChessPieceType chess_piece_index_to_type(int8_t index);
+/* 棋子编码 → 精灵索引（0..11，与 chess_pieces_small.h 一致），空格为 -1；仅供绘制 */
+extern const int8_t CHESS_PIECE_SPRITE[CHESS_PIECE_CODES];
 
-/* 棋子索引 → 颜色（0..5 黑，6..11 白） */
-ChessPieceColor chess_piece_index_to_color(int8_t index);
+static inline ChessPieceType chess_piece_type(int8_t piece) {
+    return (ChessPieceType)(piece & CHESS_PIECE_TYPE_MASK);
+}
 
-/* 是否为己方子（index 与 side 同色） */
-int chess_is_own_piece(int8_t index, int side);
+static inline ChessPieceColor chess_piece_color(int8_t piece) {
+    return (ChessPieceColor)(piece >> CHESS_PIECE_COLOR_SHIFT);
+}
+
+/* 是否为己方子（非空且颜色位等于 side） */
+static inline int chess_is_own_piece(int8_t piece, int side) {
+    return piece != CHESS_EMPTY && (piece >> CHESS_PIECE_COLOR_SHIFT) == side;
+}
 
 /* 是否为对方子 */
-int chess_is_opponent_piece(int8_t index, int side);
+static inline int chess_is_opponent_piece(int8_t piece, int side) {
+    return piece != CHESS_EMPTY && (piece >> CHESS_PIECE_COLOR_SHIFT) != side;
+}
+
+static inline int chess_piece_sprite(int8_t piece) {
+    return CHESS_PIECE_SPRITE[piece & (CHESS_PIECE_CODES - 1)];
+}
 
 #endif /* PICO_CODE_CHESS_TYPES_H */
@@ -0,0 +1,325 @@
+/**
+ * @file chess_uci.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "chess_state.h"
+#include "chess_move.h"
+#include "chess_legal.h"
+#include "chess_notation.h"
+#include "chess_search.h"
+#include "chess_epd.h"
+#include "chess_mate.h"
+#include "chess_trace.h"
+#include "chess_tt.h"
+#include "chess_engine.h"
+#include "chess_record.h"
+#include "chess_analysis.h"
+#include "chess_uci.h"
+
+#define UCI_DEFAULT_MOVES_TO_GO 30
+#define UCI_EPD_DEFAULT_MOVETIME_MS 1000
+#define UCI_ANALYZE_DEFAULT_MOVETIME_MS 500
+
+void chess_uci_init(ChessUci *u, ChessEngine *engine, ChessUciReadLine read_line, void *io_user) {
+    chess_state_init_from_initial(&u->state);
+    u->engine = engine;
+    u->read_line = read_line;
+    u->io_user = io_user;
+    u->quit = 0;
+    u->has_pending = 0;
+    chess_record_init(&u->game, &u->state);
+}
+
+/* 跳过空白，返回下一个词的起点（无则指向结尾） */
+static const char *skip_ws(const char *s) {
+    while (*s == ' ' || *s == '\t') s++;
+    return s;
+}
+
+/* 当前词是否为 word（后接空白或结尾） */
+static int word_is(const char *s, const char *word) {
+    size_t n = strlen(word);
+    return strncmp(s, word, n) == 0 && (s[n] == '\0' || s[n] == ' ' || s[n] == '\t');
+}
+
+static const char *next_word(const char *s) {
+    while (*s && *s != ' ' && *s != '\t') s++;
+    return skip_ws(s);
+}
+
+static void cmd_position(ChessUci *u, const char *args) {
+    args = skip_ws(args);
+    if (word_is(args, "startpos")) {
+        chess_state_init_from_initial(&u->state);
+        args = next_word(args);
+    } else if (word_is(args, "fen")) {
+        const char *end;
+        if (!chess_state_from_fen(&u->state, next_word(args), &end)) {
+            printf("info string invalid fen\n");
+            return;
+        }
+        args = skip_ws(end);
+        while (*args >= '0' && *args <= '9') args = next_word(args);  /* 半回合/回合计数 */
+    } else {
+        printf("info string unsupported position command\n");
+        return;
+    }
+    chess_record_init(&u->game, &u->state);
+    if (!word_is(args, "moves")) return;
+    for (args = next_word(args); *args; args = next_word(args)) {
+        ChessMove m;
+        if (!chess_move_from_uci(&u->state, args, &m)) {
+            printf("info string illegal move %.5s\n", args);
+            return;
+        }
+        chess_record_push(&u->game, &m);
+        chess_do_move(&u->state, &m);
+    }
+}
+
+static void print_score(int score) {
+    if (score > CHESS_SEARCH_MATE_BOUND)
+        printf("score mate %d", (CHESS_SEARCH_MATE - score + 1) / 2);
+    else if (score < -CHESS_SEARCH_MATE_BOUND)
+        printf("score mate -%d", (CHESS_SEARCH_MATE + score) / 2);
+    else
+        printf("score cp %d", score);
+}
+
+static void on_info(const ChessSearchInfo *info, void *user) {
+    (void)user;
+    char buf[8];
+    printf("info depth %d ", info->depth);
+    print_score(info->score);
+    printf(" nodes %lu nps %lu time %lu pv",
+           (unsigned long)info->nodes, (unsigned long)info->nps, (unsigned long)info->elapsed_ms);
+    for (int i = 0; i < info->pv_len; i++) {
+        chess_move_to_uci(&info->pv[i], buf);
+        printf(" %s", buf);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+/* 搜索中轮询输入：stop/quit 中止，isready 立即应答；其它命令暂存，之后的输入留待搜索结束再读 */
+static int poll_input(void *user) {
+    ChessUci *u = (ChessUci *)user;
+    int r;
+    while (!u->has_pending && (r = u->read_line(u->pending, sizeof(u->pending), 0, u->io_user)) != 0) {
+        if (r < 0) { u->quit = 1; return 1; }
+        const char *s = skip_ws(u->pending);
+        if (word_is(s, "stop")) { u->engine->abort = 1; return 1; }
+        if (word_is(s, "quit")) { u->quit = 1; return 1; }
+        if (word_is(s, "isready")) { printf("readyok\n"); fflush(stdout); }
+        else u->has_pending = 1;
+    }
+    return 0;
+}
+
+/* go mate N：专用杀棋求解，找到则输出 info 与 bestmove 并返回 1 */
+static int go_mate(ChessUci *u, const ChessSearchLimits *search_limits, int moves) {
+    ChessSearchLimits limits = *search_limits;
+    limits.depth = moves;
+    ChessMateResult res;
+    char buf[8];
+    if (!chess_mate_search(u->engine, &u->state, &limits, &res)) {
+        printf("info string no mate in %d (nodes %lu)\n", moves, (unsigned long)res.stats.nodes);
+        return 0;
+    }
+    printf("info depth %d score mate %d nodes %lu nps %lu time %lu pv", res.mate_in, res.mate_in,
+           (unsigned long)res.stats.nodes, (unsigned long)res.stats.nps,
+           (unsigned long)(res.stats.elapsed_us / 1000u));
+    for (int i = 0; i < res.pv_len; i++) {
+        chess_move_to_uci(&res.pv[i], buf);
+        printf(" %s", buf);
+    }
+    chess_move_to_uci(&res.best, buf);
+    printf("\nbestmove %s\n", buf);
+    fflush(stdout);
+    return 1;
+}
+
+static void cmd_go(ChessUci *u, const char *args) {
+    ChessSearchLimits limits;
+    chess_search_limits_init(&limits);
+    long wtime = -1, btime = -1, winc = 0, binc = 0, movestogo = 0;
+    int mate = 0;
+
+    for (args = skip_ws(args); *args; args = next_word(args)) {
+        const char *val = next_word(args);
+        if (word_is(args, "depth"))          limits.depth = atoi(val);
+        else if (word_is(args, "movetime"))  limits.movetime_ms = (uint32_t)strtoul(val, NULL, 10);
+        else if (word_is(args, "nodes"))     limits.nodes = (uint32_t)strtoul(val, NULL, 10);
+        else if (word_is(args, "wtime"))     wtime = atol(val);
+        else if (word_is(args, "btime"))     btime = atol(val);
+        else if (word_is(args, "winc"))      winc = atol(val);
+        else if (word_is(args, "binc"))      binc = atol(val);
+        else if (word_is(args, "movestogo")) movestogo = atol(val);
+        else if (word_is(args, "mate"))      mate = atoi(val);
+        else continue;
+        args = val;  /* 跳过数值 */
+    }
+    long my_time = (u->state.side_to_move == 1) ? wtime : btime;
+    long my_inc = (u->state.side_to_move == 1) ? winc : binc;
+    if (limits.movetime_ms == 0 && my_time >= 0) {
+        long budget = my_time / (movestogo > 0 ? movestogo : UCI_DEFAULT_MOVES_TO_GO) + my_inc / 2;
+        if (budget >= my_time) budget = my_time / 2;
+        limits.movetime_ms = (uint32_t)(budget > 1 ? budget : 1);
+    }
+
+    u->engine->abort = 0;
+    limits.poll = poll_input;
+    limits.poll_user = u;
+    limits.on_info = on_info;
+
+    ChessSearchResult res;
+    char buf[8];
+    if (mate > 0) {
+        if (go_mate(u, &limits, mate)) return;
+        /* 无杀：按 2N 层做普通搜索给出着法（已收到 stop 时立即返回首个合法着法） */
+        limits.depth = 2 * mate;
+    }
+    if (chess_search_run(u->engine, &u->state, &limits, &res)) {
+        chess_move_to_uci(&res.best, buf);
+        printf("bestmove %s\n", buf);
+    } else {
+        printf("bestmove 0000\n");
+    }
+    fflush(stdout);
+}
+
+/*
+ * epd [depth N] [nodes N] [movetime N] [mate N]：之后每行一个 EPD 局面（mate N 为解题模式），按同一预算逐个搜索并输出结果，
+ * 读到 "end" 时打印汇总（经 USB 串口运行测试集：先发命令，再发文件内容与 end）
+ */
+static void cmd_epd(ChessUci *u, const char *args) {
+    int mate = 0;
+    ChessSearchLimits limits;
+    chess_search_limits_init(&limits);
+    for (args = skip_ws(args); *args; args = next_word(args)) {
+        const char *val = next_word(args);
+        if (word_is(args, "depth"))          limits.depth = atoi(val);
+        else if (word_is(args, "movetime"))  limits.movetime_ms = (uint32_t)strtoul(val, NULL, 10);
+        else if (word_is(args, "nodes"))     limits.nodes = (uint32_t)strtoul(val, NULL, 10);
+        else if (word_is(args, "mate"))      mate = atoi(val);
+        else continue;
+        args = val;
+    }
+    if (mate == 0 && limits.depth == 0 && limits.nodes == 0 && limits.movetime_ms == 0)
+        limits.movetime_ms = UCI_EPD_DEFAULT_MOVETIME_MS;
+    u->engine->abort = 0;
+
+    ChessEpdSummary sum;
+    chess_epd_summary_clear(&sum);
+    char line[CHESS_UCI_LINE_MAX];
+    for (;;) {
+        int r = u->read_line(line, sizeof(line), 1, u->io_user);
+        if (r < 0) { u->quit = 1; break; }
+        if (r == 0) continue;
+        const char *s = skip_ws(line);
+        if (word_is(s, "end")) break;
+        if (word_is(s, "quit")) { u->quit = 1; break; }
+        chess_epd_run_line(u->engine, s, &limits, mate, &sum);
+    }
+    chess_epd_print_summary(&sum);
+}
+
+/* 分析中收到 quit 也要停下：置 abort，使 chess_analysis_step 结束整个分析 */
+static int poll_analyze(void *user) {
+    ChessUci *u = (ChessUci *)user;
+    if (!poll_input(u)) return 0;
+    u->engine->abort = 1;
+    return 1;
+}
+
+/*
+ * analyze [depth N] [movetime N] [nodes N] [fresh]：从最后一个局面倒着分析上一条 position 的整局着法，
+ * 每个局面同一预算（默认 movetime 500），共用置换表；fresh 为每个局面前清空置换表（对比共用的收益）。stop 中止。
+ */
+static void cmd_analyze(ChessUci *u, const char *args) {
+    int fresh = 0;
+    ChessSearchLimits limits;
+    chess_search_limits_init(&limits);
+    for (args = skip_ws(args); *args; args = next_word(args)) {
+        const char *val = next_word(args);
+        if (word_is(args, "fresh"))          { fresh = 1; continue; }
+        else if (word_is(args, "depth"))     limits.depth = atoi(val);
+        else if (word_is(args, "movetime"))  limits.movetime_ms = (uint32_t)strtoul(val, NULL, 10);
+        else if (word_is(args, "nodes"))     limits.nodes = (uint32_t)strtoul(val, NULL, 10);
+        else continue;
+        args = val;
+    }
+    if (limits.depth == 0 && limits.nodes == 0 && limits.movetime_ms == 0)
+        limits.movetime_ms = UCI_ANALYZE_DEFAULT_MOVETIME_MS;
+    limits.poll = poll_analyze;
+    limits.poll_user = u;
+    u->engine->abort = 0;
+
+    chess_analysis_begin(&u->analysis, &u->game);
+    do {
+        if (fresh) chess_tt_clear(&u->engine->tt);
+    } while (!chess_analysis_step(u->engine, &u->analysis, &u->game, &limits));
+    chess_analysis_print(&u->analysis, &u->game);
+}
+
+/* trace [file]：有文件名时写二进制，否则十六进制输出（设备上只能用后者） */
+static void cmd_trace(const char *args) {
+    if (*args) {
+        FILE *f = fopen(args, "wb");
+        int ok = f && chess_trace_write(f);
+        if (f) fclose(f);
+        printf("info string trace %s %lu records to %s\n", ok ? "wrote" : "failed writing",
+               (unsigned long)chess_trace_total(), args);
+        return;
+    }
+    chess_trace_dump_hex();
+}
+
+int chess_uci_handle_line(ChessUci *u, const char *line) {
+    const char *s = skip_ws(line);
+    if (word_is(s, "uci")) {
+        printf("id name PicoBoard Chess\n");
+        printf("id author PicoBoard-Games\n");
+        printf("uciok\n");
+    } else if (word_is(s, "isready")) {
+        printf("readyok\n");
+    } else if (word_is(s, "ucinewgame")) {
+        chess_state_init_from_initial(&u->state);
+        chess_engine_new_game(u->engine);
+        chess_record_init(&u->game, &u->state);
+    } else if (word_is(s, "position")) {
+        cmd_position(u, next_word(s));
+    } else if (word_is(s, "go")) {
+        cmd_go(u, next_word(s));
+    } else if (word_is(s, "epd")) {
+        cmd_epd(u, next_word(s));
+    } else if (word_is(s, "analyze")) {
+        cmd_analyze(u, next_word(s));
+    } else if (word_is(s, "trace")) {
+        cmd_trace(next_word(s));
+    } else if (word_is(s, "quit")) {
+        u->quit = 1;
+    }
+    /* stop 在空闲时无事可做；未知命令按协议忽略 */
+    fflush(stdout);
+    return !u->quit;
+}
+
+void chess_uci_loop(ChessUci *u) {
+    char line[CHESS_UCI_LINE_MAX];
+    while (!u->quit) {
+        if (u->has_pending) {
+            u->has_pending = 0;
+            strcpy(line, u->pending);
+            chess_uci_handle_line(u, line);
+            continue;
+        }
+        int r = u->read_line(line, sizeof(line), 1, u->io_user);
+        if (r < 0) break;
+        if (r == 0) continue;
+        chess_uci_handle_line(u, line);
+    }
+}
@@ -0,0 +1,45 @@
+/**
+ * @file chess_uci.h
+ * @brief UCI 协议命令循环：position / go depth|movetime|nodes / stop / isready，输出 info 与 bestmove；
+ *        position 支持 startpos 与 fen；另有非标准命令 epd（逐行运行 EPD 测试集，见 chess_epd.h）
+ *        、trace [file]（导出最近一次搜索的跟踪记录，见 chess_trace.h）
+ *        与 analyze（倒序分析 position 给出的整局着法，见 chess_analysis.h）
+ *
+ * 输出走 printf（设备上为 USB CDC stdio）；输入由前端提供的 read_line 回调读取，
+ * 搜索期间以非阻塞方式轮询，从而能响应 stop / isready / quit（stop 经 ChessEngine.abort 中止搜索）。
+ */
+
+#ifndef PICO_CODE_CHESS_UCI_H
+#define PICO_CODE_CHESS_UCI_H
+
+#include "chess_state.h"
+#include "chess_engine.h"
+#include "chess_record.h"
+#include "chess_analysis.h"
+
+#define CHESS_UCI_LINE_MAX 1024
+
+/** 读一行（不含换行）：返回 1 有一行，0 暂无（仅非阻塞时），-1 输入结束/退出 */
+typedef int (*ChessUciReadLine)(char *buf, int size, int blocking, void *user);
+
+typedef struct {
+    ChessBoardState state;
+    ChessEngine *engine;                /* 调用方持有，可与对弈界面共用 */
+    ChessUciReadLine read_line;
+    void *io_user;
+    int quit;
+    int has_pending;                    /* 搜索中读到的其它命令，搜索结束后再处理 */
+    char pending[CHESS_UCI_LINE_MAX];
+    ChessGameRecord game;               /* 最近一条 position 的起始局面与 moves */
+    ChessAnalysis analysis;
+} ChessUci;
+
+void chess_uci_init(ChessUci *u, ChessEngine *engine, ChessUciReadLine read_line, void *io_user);
+
+/** 处理一条命令；收到 quit 返回 0，否则返回 1 */
+int chess_uci_handle_line(ChessUci *u, const char *line);
+
+/** 阻塞读取并处理命令，直到 quit 或 read_line 返回 -1 */
+void chess_uci_loop(ChessUci *u);
+
+#endif /* PICO_CODE_CHESS_UCI_H */
@@ -0,0 +1,50 @@
+/**
+ * @file chess_zobrist.c
+ */
+
+#include "chess_types.h"
+#include "chess_state.h"
+#include "chess_zobrist.h"
+
+static uint64_t s_piece_keys[CHESS_PIECE_CODES][64];
+static uint64_t s_castle_keys[4];
+static uint64_t s_ep_keys[8];
+static uint64_t s_side_key;
+static int s_keys_ready;
+
+/* splitmix64：固定种子生成键，结果与初始化顺序/并发无关 */
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void chess_zobrist_init(void) {
+    if (s_keys_ready) return;
+    uint64_t seed = 0x5049434F43484553ull;  /* "PICOCHES" */
+    for (int p = 0; p < CHESS_PIECE_CODES; p++)
+        for (int sq = 0; sq < 64; sq++)
+            s_piece_keys[p][sq] = splitmix64(&seed);
+    for (int i = 0; i < 4; i++) s_castle_keys[i] = splitmix64(&seed);
+    for (int i = 0; i < 8; i++) s_ep_keys[i] = splitmix64(&seed);
+    s_side_key = splitmix64(&seed);
+    s_keys_ready = 1;
+}
+
+uint64_t chess_zobrist_hash(const ChessBoardState *b) {
+    if (!s_keys_ready) chess_zobrist_init();
+    uint64_t h = 0;
+    for (int r = 0; r < 8; r++) {
+        for (int c = 0; c < 8; c++) {
+            int8_t p = b->board[r][c];
+            if (p != CHESS_EMPTY) h ^= s_piece_keys[p][r * 8 + c];
+        }
+    }
+    for (int color = 0; color < 2; color++)
+        for (int wing = 0; wing < 2; wing++)
+            if (b->castling[color][wing]) h ^= s_castle_keys[color * 2 + wing];
+    if (b->ep_col >= 0) h ^= s_ep_keys[b->ep_col];
+    if (b->side_to_move == 1) h ^= s_side_key;
+    return h;
+}
@@ -0,0 +1,18 @@
+/**
+ * @file chess_zobrist.h
+ * @brief Zobrist 局面哈希：棋子×格、行棋方、易位资格、吃过路兵列
+ */
+
+#ifndef PICO_CODE_CHESS_ZOBRIST_H
+#define PICO_CODE_CHESS_ZOBRIST_H
+
+#include <stdint.h>
+#include "chess_state.h"
+
+/** 生成键表（固定种子，各平台一致）；多线程搜索前先调用一次（chess_engine_init 会调用） */
+void chess_zobrist_init(void);
+
+/** 计算局面哈希（未初始化时先生成键表） */
+uint64_t chess_zobrist_hash(const ChessBoardState *b);
+
+#endif /* PICO_CODE_CHESS_ZOBRIST_H */
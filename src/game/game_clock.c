@@ -0,0 +1,21 @@
+/**
+ * @file game_clock.c
+ */
+
+#include "game_clock.h"
+
+#if defined(PICO_ON_DEVICE) && defined(LIB_PICO_STDLIB)
+#include "pico/time.h"
+
+uint64_t game_clock_us(void) {
+    return to_us_since_boot(get_absolute_time());
+}
+#else
+#include <time.h>
+
+uint64_t game_clock_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)(ts.tv_nsec / 1000);
+}
+#endif
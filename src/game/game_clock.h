@@ -0,0 +1,14 @@
+/**
+ * @file game_clock.h
+ * @brief 单调微秒时钟：设备上用 pico time，主机上用 clock_gettime（供 AI 计时/统计）
+ */
+
+#ifndef PICO_CODE_GAME_CLOCK_H
+#define PICO_CODE_GAME_CLOCK_H
+
+#include <stdint.h>
+
+/** 单调递增的微秒计数（起点不定，只用于求差） */
+uint64_t game_clock_us(void);
+
+#endif /* PICO_CODE_GAME_CLOCK_H */
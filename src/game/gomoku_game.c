@@ -3,30 +3,62 @@
  * 设计要点：专业棋型权重、候选步邻域裁剪、必杀/必防预处理、移动排序
  */
 #include "game/gomoku_game.h"
+#include "game/game_clock.h"
+#include "game/gomoku_mcts.h"
+#include "game/gomoku_par.h"
+#include "game/gomoku_search.h"
+#if GOMOKU_POLICY
+#include "game/gomoku_policy.h"
+#endif
+#include "gomoku_pattern_table.h"   /* 构建时由 tools/gomoku_patterns/gen_patterns.py 生成 */
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define HU_PLAYER  1
-#define AI_PLAYER  2
+#if GMK_PATTERN_TABLE_WINDOW != 9 || GMK_PATTERN_TABLE_SHAPES != 8
+#error "gomoku_pattern_table.h does not match gomoku_game.c; regenerate it"
+#endif
 
-/* 棋型权重（与文献一致，单位：分） */
-#define SCORE_FIVE    100000
-#define SCORE_LIVE4   10000
-#define SCORE_BLOCK4  5000
-#define SCORE_LIVE3   2000
-#define SCORE_BLOCK3  500
-#define SCORE_LIVE2   100
-#define SCORE_BLOCK2  30
-
-#define SCORE_WIN   SCORE_FIVE
-#define SCORE_LOSS  (-SCORE_FIVE)
-
-/* 搜索深度：3 层（4 层在 Pico 上较慢） */
+/* 搜索深度：3 层（4 层在 Pico 上较慢）；gmk_game_init 写入 GmkGameState.ai_depth，可另行修改或用 gmk_game_set_level */
 #define AI_DEPTH       3
-#define CANDIDATE_RADIUS 2
-#define MAX_CANDIDATES  64
+/* MCTS 档每步的模拟次数上限 */
+#ifndef GMK_MCTS_PLAYOUTS
+#define GMK_MCTS_PLAYOUTS 20000
+#endif
+/* 迭代加深时每隔多少节点看一次钟 */
+#define GMK_CLOCK_CHECK_NODES 256
+/* 候选步：已有子周围 GMK_CANDIDATE_RADIUS 格内的空位，每个节点最多取 GMK_MAX_CANDIDATES 个；可在编译时覆盖 */
+#ifndef GMK_CANDIDATE_RADIUS
+#define GMK_CANDIDATE_RADIUS 2
+#endif
+#ifndef GMK_MAX_CANDIDATES
+#define GMK_MAX_CANDIDATES   64
+#endif
+/* 置换表：2^11 项 × 12 字节 = 24KB；主机上可用 -DGMK_TT_BITS=16 加大 */
+#ifndef GMK_TT_BITS
+#define GMK_TT_BITS          11
+#endif
+#define GMK_TT_SIZE          (1u << GMK_TT_BITS)
+/* 盘上不超过这么多子时，哈希取 8 种对称（旋转/镜像）中最小的键，对称的开局共用表项 */
+#ifndef GMK_TT_SYM_STONES
+#define GMK_TT_SYM_STONES    12
+#endif
+/* VCF（连续冲四）：进攻方最多连冲 GMK_VCF_DEPTH 手，每次求解最多 GMK_VCF_NODES 个节点 */
+#ifndef GMK_VCF_DEPTH
+#define GMK_VCF_DEPTH        12
+#endif
+#ifndef GMK_VCF_NODES
+#define GMK_VCF_NODES        4000
+#endif
+#define GMK_VCF_MEMO_BITS    10
+/* 策略网络剪枝（GOMOKU_POLICY）：内部节点保留 logit 最高的这么多个候选，另加置换表着法、杀手着法与双方的成四点 */
+#ifndef GMK_POLICY_TOP_K
+#define GMK_POLICY_TOP_K     12
+#endif
+/* 着法排序：杀手着法每层记 2 个（GMK_MAX_PLY 层，见 gomoku_search.h） */
+#define KILLER_BONUS         SCORE_LIVE3
+#define HASH_MOVE_SCORE      (1 << 30)
 
 static const int DR[4] = { 0, 1, 1,  1 };
 static const int DC[4] = { 1, 0, 1, -1 };
@@ -63,227 +95,814 @@ static bool is_draw(const GmkGameState *g) {
   return true;
 }
 
-/* ---------- 棋型：单路（沿方向 dr,dc）的连续子数及两端是否为空 ---------- */
-static int get_run_info(const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE], int r, int c, int dr, int dc,
-                        uint8_t player, int *left_empty, int *right_empty) {
-  int L = 0;
-  int r0 = r, c0 = c;
-  while (r0 >= 0 && r0 < GOMOKU_SIZE && c0 >= 0 && c0 < GOMOKU_SIZE && b[r0][c0] == player) {
-    L++;
-    r0 -= dr; c0 -= dc;
+/* ---------- 棋型：按线缓存，落子/提子只重算经过该点的 4 条线 ---------- */
+/* 线上第 i 格存在 bit (i + LINE_PAD)：两端各留 4 位，取 9 格窗口时不必判越界 */
+#define LINE_PAD   4
+
+/* 棋型查表（gomoku_pattern_table.h）：低 4 位为棋型，与 gen_patterns.py 的编号一致；HEAD 为子组首子 */
+#define PAT_SHAPE_MASK 0x0F
+#define PAT_HEAD       0x10
+enum { SHAPE_NONE, SHAPE_BLOCK2, SHAPE_LIVE2, SHAPE_BLOCK3, SHAPE_LIVE3, SHAPE_BLOCK4, SHAPE_LIVE4, SHAPE_FIVE };
+
+static const int s_shape_score[GMK_PATTERN_TABLE_SHAPES] = {
+  0, SCORE_BLOCK2, SCORE_LIVE2, SCORE_BLOCK3, SCORE_LIVE3, SCORE_BLOCK4, SCORE_LIVE4, SCORE_FIVE
+};
+
+
+/* (r,c) 在方向 d 上所属的线号；位于短于 5 的斜线上时返回 -1 */
+static int line_id(int r, int c, int d) {
+  int k;
+  switch (d) {
+    case 0: return r;
+    case 1: return GOMOKU_SIZE + c;
+    case 2: k = r - c + (GOMOKU_SIZE - 5); break;
+    default: k = r + c - 4; break;
   }
-  *left_empty = (r0 >= 0 && r0 < GOMOKU_SIZE && c0 >= 0 && c0 < GOMOKU_SIZE && b[r0][c0] == 0) ? 1 : 0;
-  r0 = r + dr; c0 = c + dc;
-  while (r0 >= 0 && r0 < GOMOKU_SIZE && c0 >= 0 && c0 < GOMOKU_SIZE && b[r0][c0] == player) {
-    L++;
-    r0 += dr; c0 += dc;
+  if (k < 0 || k >= DIAG_LINES) return -1;
+  return 2 * GOMOKU_SIZE + (d == 3 ? DIAG_LINES : 0) + k;
+}
+
+/* 线号 -> 起点与方向 */
+static void line_start(int id, int *r, int *c, int *d) {
+  if (id < GOMOKU_SIZE) { *r = id; *c = 0; *d = 0; return; }
+  id -= GOMOKU_SIZE;
+  if (id < GOMOKU_SIZE) { *r = 0; *c = id; *d = 1; return; }
+  id -= GOMOKU_SIZE;
+  if (id < DIAG_LINES) {
+    int k = id - (GOMOKU_SIZE - 5);   /* r - c */
+    *r = k > 0 ? k : 0; *c = k < 0 ? -k : 0; *d = 2;
+    return;
   }
-  *right_empty = (r0 >= 0 && r0 < GOMOKU_SIZE && c0 >= 0 && c0 < GOMOKU_SIZE && b[r0][c0] == 0) ? 1 : 0;
-  return L;
+  int sum = id - DIAG_LINES + 4;      /* r + c */
+  *r = sum > GOMOKU_SIZE - 1 ? sum - (GOMOKU_SIZE - 1) : 0;
+  *c = sum - *r; *d = 3;
 }
 
-/* 仅当 (r,c) 为该方向上的“起点”时计分，避免重复计同一段 */
-static int run_score(int L, int left_ok, int right_ok) {
-  if (L >= 5) return SCORE_FIVE;
-  if (L == 4) {
-    if (left_ok && right_ok) return SCORE_LIVE4;
-    if (left_ok || right_ok) return SCORE_BLOCK4;
-    return 0;
+/* (r,c) 在方向 d 的线上是第几格（从线的起点数） */
+static int line_pos(int r, int c, int d) {
+  switch (d) {
+    case 0: return c;
+    case 1: return r;
+    case 2: return r < c ? r : c;
+    default: return r + c > GOMOKU_SIZE - 1 ? r - (r + c - (GOMOKU_SIZE - 1)) : r;
   }
-  if (L == 3) {
-    if (left_ok && right_ok) return SCORE_LIVE3;
-    if (left_ok || right_ok) return SCORE_BLOCK3;
-    return 0;
+}
+
+static int line_len(int id) {
+  if (id < 2 * GOMOKU_SIZE) return GOMOKU_SIZE;
+  int k = (id - 2 * GOMOKU_SIZE) % DIAG_LINES - (GOMOKU_SIZE - 5);   /* 距主对角线的偏移 */
+  return GOMOKU_SIZE - (k < 0 ? -k : k);
+}
+
+/* 线外的位（两端填充与线长以外）视为挡 */
+static uint32_t line_wall(int id) {
+  return ~(((1u << line_len(id)) - 1) << LINE_PAD);
+}
+
+/* 以 bit i + LINE_PAD 为中心的 9 格窗口查表：own 为己方位图，blocked 为对方子与线外 */
+static uint8_t pattern_at(uint32_t own, uint32_t blocked, int i) {
+  return gmk_pattern_table[gmk_pattern_ternary[(own >> i) & 0x1FF] + 2 * gmk_pattern_ternary[(blocked >> i) & 0x1FF]];
+}
+
+/* 重算一条线：双方各自在每个子组首子处查表计分，并把差值记入两方总分 */
+static void rescore_line(GmkSearch *s, int id) {
+  uint32_t wall = line_wall(id);
+  for (int p = 0; p < 2; p++) {
+    uint32_t own = s->line_bits[id][p], blocked = s->line_bits[id][1 - p] | wall;
+    int score = 0;
+    for (uint32_t m = own; m; m &= m - 1) {
+      uint8_t e = pattern_at(own, blocked, __builtin_ctz(m) - LINE_PAD);
+      if (e & PAT_HEAD) score += s_shape_score[e & PAT_SHAPE_MASK];
+    }
+    s->total[p] += score - s->line_score[id][p];
+    s->line_score[id][p] = score;
   }
-  if (L == 2) {
-    if (left_ok && right_ok) return SCORE_LIVE2;
-    if (left_ok || right_ok) return SCORE_BLOCK2;
-    return 0;
+}
+
+/* 线上第 j 格对应的棋盘格 */
+static void line_cell(int id, int j, int *r, int *c) {
+  int d;
+  line_start(id, r, c, &d);
+  *r += j * DR[d];
+  *c += j * DC[d];
+}
+
+/* 换上线 id 的一类威胁位，变化的格同步到每格计数与位图 */
+static void set_line_threat(GmkSearch *s, int id, int p, int k, uint16_t mask) {
+  uint16_t changed = (uint16_t)(s->line_threat[id][p][k] ^ mask);
+  for (; changed; changed &= (uint16_t)(changed - 1)) {
+    int j = __builtin_ctz(changed), r, c;
+    line_cell(id, j, &r, &c);
+    uint8_t *cnt = &s->threat_cnt[p][k][r][c];
+    if (mask & (1u << j)) {
+      if ((*cnt)++ == 0) { s->threat_rows[p][k][r] |= (uint16_t)(1u << c); s->threat_cells[p][k]++; }
+    } else {
+      if (--(*cnt) == 0) { s->threat_rows[p][k][r] &= (uint16_t)~(1u << c); s->threat_cells[p][k]--; }
+    }
   }
-  return 0;
+  s->line_threat[id][p][k] = mask;
 }
 
-/* 对某一方，在 (r,c) 沿 (dr,dc) 方向的棋型分（仅当 (r-dr,c-dc) 不是同色时计入） */
-static int pattern_at(const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE], int r, int c, int dr, int dc, uint8_t player) {
-  int pr = r - dr, pc = c - dc;
-  if (pr >= 0 && pr < GOMOKU_SIZE && pc >= 0 && pc < GOMOKU_SIZE && b[pr][pc] == player)
-    return 0;
-  int le, re;
-  int L = get_run_info(b, r, c, dr, dc, player, &le, &re);
-  return run_score(L, le, re);
+/* 重算线 id 上第 lo..hi 格的威胁位。full 的 bit p 为 1 时该方逐格查表；
+ * 否则该方只可能失去威胁（对方刚落子），只复查已标记的格 */
+static void update_line_threats(GmkSearch *s, int id, int lo, int hi, unsigned full) {
+  uint32_t wall = line_wall(id);
+  uint32_t occupied = s->line_bits[id][0] | s->line_bits[id][1] | wall;
+  uint16_t range = (uint16_t)(((1u << (hi - lo + 1)) - 1) << lo);
+  for (int p = 0; p < 2; p++) {
+    uint32_t own = s->line_bits[id][p], blocked = s->line_bits[id][1 - p] | wall;
+    uint16_t mask[2] = { s->line_threat[id][p][THREAT_FIVE], s->line_threat[id][p][THREAT_FOUR] };
+    uint16_t check = (full >> p & 1) ? range : (uint16_t)((mask[THREAT_FIVE] | mask[THREAT_FOUR]) & range);
+    mask[THREAT_FIVE] &= (uint16_t)~check;
+    mask[THREAT_FOUR] &= (uint16_t)~check;
+    for (; check; check &= (uint16_t)(check - 1)) {
+      int j = __builtin_ctz(check);
+      if (occupied & (1u << (j + LINE_PAD))) continue;
+      uint32_t win = (own >> j) & 0x1ffu;   /* 以 j 为中心的 9 格；不足 3 个己方子成不了四 */
+      win &= win - 1;
+      if (!(win & (win - 1))) continue;
+      int shape = pattern_at(own | (1u << (j + LINE_PAD)), blocked, j) & PAT_SHAPE_MASK;
+      if (shape == SHAPE_FIVE) mask[THREAT_FIVE] |= (uint16_t)(1u << j);
+      else if (shape >= SHAPE_BLOCK4) mask[THREAT_FOUR] |= (uint16_t)(1u << j);
+    }
+    set_line_threat(s, id, p, THREAT_FIVE, mask[THREAT_FIVE]);
+    set_line_threat(s, id, p, THREAT_FOUR, mask[THREAT_FOUR]);
+  }
 }
 
-/* 全盘对 player 的棋型总分（四方向，每段只从起点计一次） */
-static int side_pattern_score(const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE], uint8_t player) {
-  int total = 0;
+/* player 的某类威胁格中行优先的第一个；没有返回 false */
+bool gmk_search_first_threat(const GmkSearch *s, uint8_t player, int kind, int *out_r, int *out_c) {
+  if (s->threat_cells[player - 1][kind] == 0) return false;
   for (int r = 0; r < GOMOKU_SIZE; r++) {
-    for (int c = 0; c < GOMOKU_SIZE; c++) {
-      if (b[r][c] != player) continue;
-      for (int d = 0; d < 4; d++)
-        total += pattern_at(b, r, c, DR[d], DC[d], player);
+    uint16_t row = s->threat_rows[player - 1][kind][r];
+    if (row) { *out_r = r; *out_c = __builtin_ctz(row); return true; }
+  }
+  return false;
+}
+
+/* (r,c) 落子（delta = 1，b 已置子）或提子（delta = -1，b 已清空）后更新周围的邻域计数与候选位 */
+static void near_update(GmkSearch *s, int r, int c, int delta) {
+  int r0 = r - GMK_CANDIDATE_RADIUS, r1 = r + GMK_CANDIDATE_RADIUS;
+  int c0 = c - GMK_CANDIDATE_RADIUS, c1 = c + GMK_CANDIDATE_RADIUS;
+  if (r0 < 0) r0 = 0;
+  if (c0 < 0) c0 = 0;
+  if (r1 > GOMOKU_SIZE - 1) r1 = GOMOKU_SIZE - 1;
+  if (c1 > GOMOKU_SIZE - 1) c1 = GOMOKU_SIZE - 1;
+  for (int rr = r0; rr <= r1; rr++) {
+    uint16_t row = s->cand_rows[rr];
+    for (int cc = c0; cc <= c1; cc++) {
+      s->near[rr][cc] = (uint8_t)(s->near[rr][cc] + delta);
+      if (s->b[rr][cc] == 0 && s->near[rr][cc] != 0) row |= (uint16_t)(1u << cc);
+      else row &= (uint16_t)~(1u << cc);
     }
+    s->cand_rows[rr] = row;
+  }
+  s->stones += delta;
+}
+
+/* ---------- Zobrist 哈希与置换表 ---------- */
+static uint64_t s_zobrist[2][GOMOKU_SIZE * GOMOKU_SIZE];
+static uint64_t s_zobrist_side;          /* 轮到 AI 时异或 */
+static bool s_zobrist_ready;
+
+/* splitmix64：固定种子生成键 */
+static uint64_t splitmix64(uint64_t *x) {
+  uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+static void zobrist_init(void) {
+  if (s_zobrist_ready) return;
+  uint64_t seed = 0x5049434F474D4B55ull;   /* "PICOGMKU" */
+  for (int p = 0; p < 2; p++)
+    for (int i = 0; i < GOMOKU_SIZE * GOMOKU_SIZE; i++) s_zobrist[p][i] = splitmix64(&seed);
+  s_zobrist_side = splitmix64(&seed);
+  s_zobrist_ready = true;
+}
+
+/* 第 t 种对称：bit 2 先转置，bit 0 上下翻，bit 1 左右翻；sym_unmap 为其逆 */
+static int sym_map(int t, int r, int c) {
+  if (t & 4) { int x = r; r = c; c = x; }
+  if (t & 1) r = GOMOKU_SIZE - 1 - r;
+  if (t & 2) c = GOMOKU_SIZE - 1 - c;
+  return r * GOMOKU_SIZE + c;
+}
+
+static int sym_unmap(int t, int cell) {
+  int r = cell / GOMOKU_SIZE, c = cell % GOMOKU_SIZE;
+  if (t & 1) r = GOMOKU_SIZE - 1 - r;
+  if (t & 2) c = GOMOKU_SIZE - 1 - c;
+  if (t & 4) { int x = r; r = c; c = x; }
+  return r * GOMOKU_SIZE + c;
+}
+
+/* 子数超过 GMK_TT_SYM_STONES 后只用原盘的键，其余 7 个不再更新（落子、提子按同一子数判断，回到门限内时仍然正确） */
+static void zobrist_toggle(GmkSearch *s, int r, int c, uint8_t player) {
+  int syms = s->stones <= GMK_TT_SYM_STONES ? 8 : 1;
+  for (int t = 0; t < syms; t++) s->keys[t] ^= s_zobrist[player - 1][sym_map(t, r, c)];
+}
+
+enum { TT_NONE = 0, TT_EXACT, TT_LOWER, TT_UPPER };
+
+typedef struct {
+  uint32_t check;     /* 键高 32 位异或另两个字（见 tt_check），用于校验 */
+  int32_t score;
+  int8_t depth;
+  uint8_t bound;
+  uint8_t best;       /* 最佳着法（规范盘面上的 r*15+c）；无则为 0xFF */
+  uint8_t pad;
+} GmkTTEntry;
+
+/* 根节点并行时各 worker 不加锁地读写同一张表：校验字混入另两个字，读到写了一半的表项时校验不过，当作未命中 */
+static uint32_t tt_check(uint32_t key_hi, const GmkTTEntry *e) {
+  return key_hi ^ (uint32_t)e->score ^
+         ((uint32_t)(uint8_t)e->depth | ((uint32_t)e->bound << 8) | ((uint32_t)e->best << 16));
+}
+
+/* VCF 备忘：键 -> 是否有杀；无杀只在求解未因节点上限中断时记录，并记下当时的剩余手数 */
+typedef struct {
+  uint32_t check;
+  uint8_t depth;
+  uint8_t win;
+  uint8_t pad[2];
+} GmkVcfMemo;
+
+/* AI 上下文：置换表与 VCF 备忘跨着保留（键只由盘面与轮到谁决定），gmk_game_init 时清空；
+ * search 为 gmk_game_ai_move 的根局面（约 5.3KB），和表一起放堆上以免压栈；
+ * mcts 为 MCTS 档的节点池（Pico 上约 21KB），与上下文一起分配，没有时 MCTS 档退回 Alpha-Beta；
+ * 根节点并行另外的 workers - 1 个 worker 局面与其栈（Pico 上为 core1 的 16KB）也在这里预留，搜索时不再分配 */
+struct GmkAiContext {
+  GmkTTEntry tt[GMK_TT_SIZE];
+  GmkVcfMemo vcf_memo[1u << GMK_VCF_MEMO_BITS];
+  GmkSearch search;
+  GmkMcts *mcts;
+  int workers;
+  GmkSearch *worker_pos;
+  void *par_stack;
+};
+
+static int clamp_workers(int workers) {
+  return workers < 1 ? 1 : workers > GMK_MAX_WORKERS ? GMK_MAX_WORKERS : workers;
+}
+
+GmkAiContext *gmk_ai_context_new(bool mcts, int workers) {
+  GmkAiContext *ai = malloc(sizeof(*ai));
+  if (!ai) return NULL;
+  memset(ai, 0, sizeof(*ai));
+  ai->workers = clamp_workers(workers);
+  size_t stack = gmk_par_stack_bytes(ai->workers);
+  bool ok = true;
+  if (mcts) ok = (ai->mcts = malloc(sizeof(GmkMcts))) != NULL;
+  if (ok && ai->workers > 1) ok = (ai->worker_pos = malloc((size_t)(ai->workers - 1) * sizeof(GmkSearch))) != NULL;
+  if (ok && stack) ok = (ai->par_stack = malloc(stack)) != NULL;
+  if (!ok) {
+    gmk_ai_context_free(ai);
+    return NULL;
   }
-  return total;
+  return ai;
+}
+
+void gmk_ai_context_free(GmkAiContext *ai) {
+  if (!ai) return;
+  free(ai->mcts);
+  free(ai->worker_pos);
+  free(ai->par_stack);
+  free(ai);
+}
+
+size_t gmk_ai_context_size(bool mcts, int workers) {
+  workers = clamp_workers(workers);
+  return sizeof(GmkAiContext) + (mcts ? sizeof(GmkMcts) : 0) + (size_t)(workers - 1) * sizeof(GmkSearch) +
+         gmk_par_stack_bytes(workers);
+}
+
+/* 本节点的键与对称号：子少时取 8 个键中最小的，否则用原盘 */
+static uint64_t tt_key(const GmkSearch *s, bool maximizing, int *sym) {
+  int t = 0;
+  if (s->stones <= GMK_TT_SYM_STONES)
+    for (int i = 1; i < 8; i++)
+      if (s->keys[i] < s->keys[t]) t = i;
+  *sym = t;
+  return s->keys[t] ^ (maximizing ? s_zobrist_side : 0);
+}
+
+/* 命中时把表项复制到 out */
+static bool tt_probe(GmkSearch *s, uint64_t key, GmkTTEntry *out) {
+  *out = s->ai->tt[key & (GMK_TT_SIZE - 1)];
+  s->tt_probes++;
+  if (out->bound == TT_NONE || out->check != tt_check((uint32_t)(key >> 32), out)) return false;
+  s->tt_hits++;
+  return true;
+}
+
+/* 深度优先替换；同一局面更浅的结果不覆盖 */
+static void tt_store(GmkSearch *s, uint64_t key, int depth, int score, int bound, int best) {
+  GmkTTEntry *slot = &s->ai->tt[key & (GMK_TT_SIZE - 1)];
+  GmkTTEntry old = *slot, e;
+  uint32_t key_hi = (uint32_t)(key >> 32);
+  if (old.bound != TT_NONE && old.check == tt_check(key_hi, &old) && old.depth > depth) return;
+  e.score = score;
+  e.depth = (int8_t)depth;
+  e.bound = (uint8_t)bound;
+  e.best = (uint8_t)best;
+  e.pad = 0;
+  e.check = tt_check(key_hi, &e);
+  *slot = e;
+}
+
+void gmk_search_init(GmkSearch *s, const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE]) {
+  memcpy(s->b, b, sizeof(s->b));
+  memset(s->line_bits, 0, sizeof(s->line_bits));
+  memset(s->line_score, 0, sizeof(s->line_score));
+  s->total[0] = s->total[1] = 0;
+  s->nodes = 0;
+  s->gen_us = 0;
+  s->tt_probes = s->tt_hits = s->tt_cuts = 0;
+  s->vcf_nodes = 0;
+  s->deadline = 0;
+  s->aborted = false;
+  s->policy_k = 0;
+  s->ai = NULL;
+  memset(s->killers, 0xFF, sizeof(s->killers));
+  memset(s->history, 0, sizeof(s->history));
+  zobrist_init();
+  memset(s->keys, 0, sizeof(s->keys));
+  for (int r = 0; r < GOMOKU_SIZE; r++)
+    for (int c = 0; c < GOMOKU_SIZE; c++) {
+      if (b[r][c] == 0) continue;
+      for (int d = 0; d < 4; d++) {
+        int id = line_id(r, c, d);
+        if (id >= 0) s->line_bits[id][b[r][c] - 1] |= 1u << (line_pos(r, c, d) + LINE_PAD);
+      }
+    }
+  for (int id = 0; id < GMK_LINES; id++) rescore_line(s, id);
+  memset(s->line_threat, 0, sizeof(s->line_threat));
+  memset(s->threat_cnt, 0, sizeof(s->threat_cnt));
+  memset(s->threat_rows, 0, sizeof(s->threat_rows));
+  memset(s->threat_cells, 0, sizeof(s->threat_cells));
+  for (int id = 0; id < GMK_LINES; id++) update_line_threats(s, id, 0, line_len(id) - 1, 3);
+  memset(s->near, 0, sizeof(s->near));
+  memset(s->cand_rows, 0, sizeof(s->cand_rows));
+  s->stones = 0;
+  for (int r = 0; r < GOMOKU_SIZE; r++)
+    for (int c = 0; c < GOMOKU_SIZE; c++)
+      if (b[r][c] != 0) near_update(s, r, c, 1);
+  for (int r = 0; r < GOMOKU_SIZE; r++)
+    for (int c = 0; c < GOMOKU_SIZE; c++)
+      if (b[r][c] != 0)
+        for (int t = 0; t < 8; t++) s->keys[t] ^= s_zobrist[b[r][c] - 1][sym_map(t, r, c)];
 }
 
 /* 局面评估：正数对 AI 有利。若已有五连则返回胜负分 */
-static int evaluate(const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE]) {
-  int ai_s = side_pattern_score(b, AI_PLAYER);
-  int hu_s = side_pattern_score(b, HU_PLAYER);
+int gmk_search_evaluate(const GmkSearch *s) {
+  int ai_s = s->total[AI_PLAYER - 1];
+  int hu_s = s->total[HU_PLAYER - 1];
   if (ai_s >= SCORE_FIVE) return SCORE_WIN;
   if (hu_s >= SCORE_FIVE) return SCORE_LOSS;
   return ai_s - hu_s;
 }
 
-/* ---------- 候选步：仅考虑已有子周围 CANDIDATE_RADIUS 格内的空位 ---------- */
-typedef struct { int r; int c; int score; } Candidate;
+/* 落子：只重算经过 (r,c) 的线 */
+static void place_stone(GmkSearch *s, int r, int c, uint8_t player, GmkUndo *u) {
+  s->b[r][c] = player;
+  for (int d = 0; d < 4; d++) {
+    int id = line_id(r, c, d);
+    if (id < 0) continue;
+    s->line_bits[id][player - 1] |= 1u << (line_pos(r, c, d) + LINE_PAD);
+    u->score[d][0] = s->line_score[id][0];
+    u->score[d][1] = s->line_score[id][1];
+    rescore_line(s, id);
+  }
+}
 
-static bool in_neighborhood(const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE], int r, int c) {
-  for (int rr = r - CANDIDATE_RADIUS; rr <= r + CANDIDATE_RADIUS; rr++)
-    for (int cc = c - CANDIDATE_RADIUS; cc <= c + CANDIDATE_RADIUS; cc++) {
-      if (rr < 0 || rr >= GOMOKU_SIZE || cc < 0 || cc >= GOMOKU_SIZE) continue;
-      if (b[rr][cc] != 0) return true;
+static void remove_stone(GmkSearch *s, int r, int c, const GmkUndo *u) {
+  uint8_t player = s->b[r][c];
+  s->b[r][c] = 0;
+  for (int d = 0; d < 4; d++) {
+    int id = line_id(r, c, d);
+    if (id < 0) continue;
+    s->line_bits[id][player - 1] &= ~(1u << (line_pos(r, c, d) + LINE_PAD));
+    for (int p = 0; p < 2; p++) {
+      s->total[p] += u->score[d][p] - s->line_score[id][p];
+      s->line_score[id][p] = u->score[d][p];
     }
-  return false;
+  }
 }
 
-static bool has_any_piece(const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE]) {
-  for (int r = 0; r < GOMOKU_SIZE; r++)
-    for (int c = 0; c < GOMOKU_SIZE; c++)
-      if (b[r][c] != 0) return true;
-  return false;
+/* ---------- 候选步：直接读候选位图（已有子周围 GMK_CANDIDATE_RADIUS 格内的空位） ---------- */
+typedef struct { int r; int c; int score; } Candidate;
+
+/* 搜索中真正走一步/退一步：棋型线、邻域计数、威胁索引与 Zobrist 键一起更新。
+ * 威胁只可能在经过落点的 4 条线、距它 4 格以内变化：落子方逐格重算，对方只复查已有的威胁；退一步时原样恢复 */
+void gmk_search_make(GmkSearch *s, int r, int c, uint8_t player, GmkUndo *u) {
+  place_stone(s, r, c, player, u);
+  near_update(s, r, c, 1);
+  zobrist_toggle(s, r, c, player);
+  for (int d = 0; d < 4; d++) {
+    int id = line_id(r, c, d);
+    if (id < 0) continue;
+    memcpy(u->threat[d], s->line_threat[id], sizeof(u->threat[d]));
+    int i = line_pos(r, c, d), len = line_len(id);
+    update_line_threats(s, id, i - 4 < 0 ? 0 : i - 4, i + 4 > len - 1 ? len - 1 : i + 4, 1u << (player - 1));
+  }
+}
+
+void gmk_search_unmake(GmkSearch *s, int r, int c, const GmkUndo *u) {
+  zobrist_toggle(s, r, c, s->b[r][c]);
+  remove_stone(s, r, c, u);
+  near_update(s, r, c, -1);
+  for (int d = 0; d < 4; d++) {
+    int id = line_id(r, c, d);
+    if (id < 0) continue;
+    for (int p = 0; p < 2; p++)
+      for (int k = 0; k < 2; k++) set_line_threat(s, id, p, k, u->threat[d][p][k]);
+  }
 }
 
-static int collect_candidates(const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE],
-                              Candidate *out, int max_out, bool for_ai) {
+/* player 在空位 (r,c) 落子的局部棋型分：经过该点的 4 条线上，己方在此能成的棋型加上对方在此能成（即被挡住）的棋型 */
+int gmk_search_cell_score(const GmkSearch *s, int r, int c, uint8_t player) {
+  int score = 0;
+  for (int d = 0; d < 4; d++) {
+    int id = line_id(r, c, d);
+    if (id < 0) continue;
+    int i = line_pos(r, c, d);
+    uint32_t bit = 1u << (i + LINE_PAD), wall = line_wall(id);
+    uint32_t own = s->line_bits[id][player - 1], opp = s->line_bits[id][2 - player];
+    score += s_shape_score[pattern_at(own | bit, opp | wall, i) & PAT_SHAPE_MASK];
+    score += s_shape_score[pattern_at(opp | bit, own | wall, i) & PAT_SHAPE_MASK];
+  }
+  return score;
+}
+
+/* 候选步与排序分（对 player 越大越好）：置换表着法最先，其次杀手着法加分，其余按局部棋型分与历史分 */
+static int collect_candidates(GmkSearch *s, Candidate *out, int max_out, uint8_t player, int hash_cell, int ply) {
+  uint64_t t0 = game_clock_us();
   int n = 0;
-  uint8_t copy[GOMOKU_SIZE][GOMOKU_SIZE];
-  memcpy(copy, b, sizeof(copy));
-  bool use_neighborhood = has_any_piece(b);
   /* 开局无子时只考虑中腹，减少首步分支 */
-  int r0 = 0, r1 = GOMOKU_SIZE, c0 = 0, c1 = GOMOKU_SIZE;
-  if (!use_neighborhood) {
-    int center = GOMOKU_SIZE / 2;
-    int margin = 3;
-    r0 = center - margin; r1 = center + margin + 1;
-    c0 = center - margin; c1 = center + margin + 1;
-    if (r0 < 0) r0 = 0; if (c0 < 0) c0 = 0;
-    if (r1 > GOMOKU_SIZE) r1 = GOMOKU_SIZE; if (c1 > GOMOKU_SIZE) c1 = GOMOKU_SIZE;
-  }
-  for (int r = r0; r < r1 && n < max_out; r++) {
-    for (int c = c0; c < c1 && n < max_out; c++) {
-      if (copy[r][c] != 0) continue;
-      if (use_neighborhood && !in_neighborhood(copy, r, c)) continue;
+  int center = GOMOKU_SIZE / 2;
+  int margin = 3;
+  uint16_t center_cols = (uint16_t)(((1u << (2 * margin + 1)) - 1) << (center - margin));
+  const int16_t *killer = ply < GMK_MAX_PLY ? s->killers[ply] : NULL;
+  for (int r = 0; r < GOMOKU_SIZE && n < max_out; r++) {
+    uint16_t row = s->cand_rows[r];
+    if (s->stones == 0) row = (abs(r - center) <= margin) ? center_cols : 0;
+    for (; row && n < max_out; row &= (uint16_t)(row - 1)) {
+      int c = __builtin_ctz(row), cell = r * GOMOKU_SIZE + c;
       out[n].r = r; out[n].c = c;
-      copy[r][c] = for_ai ? AI_PLAYER : HU_PLAYER;
-      out[n].score = evaluate(copy);
-      copy[r][c] = 0;
+      if (cell == hash_cell) {
+        out[n].score = HASH_MOVE_SCORE;
+      } else {
+        out[n].score = gmk_search_cell_score(s, r, c, player) + (int)(s->history[player - 1][cell] >> 4);
+        if (killer && (cell == killer[0] || cell == killer[1])) out[n].score += KILLER_BONUS;
+      }
       n++;
     }
   }
+  s->gen_us += (uint32_t)(game_clock_us() - t0);
   return n;
 }
 
-/* 简单插入排序：按 score 降序（AI 先试高分，Human 先试低分，有利于剪枝） */
-static void sort_candidates_max(Candidate *c, int n) {
-  for (int i = 1; i < n; i++) {
-    Candidate t = c[i];
-    int j = i;
-    while (j > 0 && c[j - 1].score < t.score) { c[j] = c[j - 1]; j--; }
-    c[j] = t;
+#if GOMOKU_POLICY
+/* 只留策略网络 logit 最高的 policy_k 个候选；置换表着法、杀手着法与双方的成四点总是保留。排序分不变 */
+static int policy_prune(GmkSearch *s, Candidate *cand, int n, uint8_t player, int ply) {
+  uint64_t t0 = game_clock_us();
+  int32_t logit[GMK_MAX_CANDIDATES];
+  const int16_t *killer = ply < GMK_MAX_PLY ? s->killers[ply] : NULL;
+  int keep = 0;
+  for (int i = 0; i < n; i++) {
+    int r = cand[i].r, c = cand[i].c, cell = r * GOMOKU_SIZE + c;
+    uint16_t bit = (uint16_t)(1u << c);
+    if (cand[i].score >= HASH_MOVE_SCORE || (killer && (cell == killer[0] || cell == killer[1])) ||
+        (s->threat_rows[0][THREAT_FOUR][r] & bit) || (s->threat_rows[1][THREAT_FOUR][r] & bit)) {
+      logit[i] = INT32_MAX;
+      keep++;
+    } else {
+      logit[i] = gmk_policy_logit(s, r, c, player);
+    }
   }
+  int k = keep > s->policy_k ? keep : s->policy_k;
+  for (int i = 0; i < k; i++) {
+    int best = i;
+    for (int j = i + 1; j < n; j++)
+      if (logit[j] > logit[best]) best = j;
+    Candidate tc = cand[i];
+    int32_t tl = logit[i];
+    cand[i] = cand[best]; logit[i] = logit[best];
+    cand[best] = tc; logit[best] = tl;
+  }
+  s->gen_us += (uint32_t)(game_clock_us() - t0);
+  return k;
 }
-static void sort_candidates_min(Candidate *c, int n) {
-  for (int i = 1; i < n; i++) {
+#endif
+
+/* 部分选择排序：把 c[i..n-1] 中分最高的换到 i。多数节点在前几个候选就截断，后面的不必排 */
+static void pick_candidate(Candidate *c, int i, int n) {
+  int best = i;
+  for (int j = i + 1; j < n; j++)
+    if (c[j].score > c[best].score) best = j;
+  if (best != i) {
     Candidate t = c[i];
-    int j = i;
-    while (j > 0 && c[j - 1].score > t.score) { c[j] = c[j - 1]; j--; }
-    c[j] = t;
+    c[i] = c[best];
+    c[best] = t;
   }
 }
 
-/* ---------- 必杀：下一步成五；必防：对方活四/冲四的防点 ---------- */
-static bool would_win(const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE], int r, int c, uint8_t player) {
-  uint8_t tmp[GOMOKU_SIZE][GOMOKU_SIZE];
-  memcpy(tmp, b, sizeof(tmp));
-  tmp[r][c] = player;
-  for (int d = 0; d < 4; d++) {
-    int cnt = 1;
-    int rr = r + DR[d], cc = c + DC[d];
-    while (rr >= 0 && rr < GOMOKU_SIZE && cc >= 0 && cc < GOMOKU_SIZE && tmp[rr][cc] == player) {
-      cnt++; rr += DR[d]; cc += DC[d];
-    }
-    rr = r - DR[d]; cc = c - DC[d];
-    while (rr >= 0 && rr < GOMOKU_SIZE && cc >= 0 && cc < GOMOKU_SIZE && tmp[rr][cc] == player) {
-      cnt++; rr -= DR[d]; cc -= DC[d];
-    }
-    if (cnt >= 5) return true;
+/* 截断着法记为本层杀手，并按 depth^2 加历史分 */
+static void note_cutoff(GmkSearch *s, int r, int c, uint8_t player, int depth, int ply) {
+  int cell = r * GOMOKU_SIZE + c;
+  s->history[player - 1][cell] += (uint32_t)(depth * depth);
+  if (ply >= GMK_MAX_PLY || s->killers[ply][0] == cell) return;
+  s->killers[ply][1] = s->killers[ply][0];
+  s->killers[ply][0] = (int16_t)cell;
+}
+
+/* ---------- VCF：进攻方只走成四的棋，防守方只能挡唯一的成五点 ---------- */
+/* 本次求解到节点上限，或有时间预算（deadline）且已到点；到点时把上限收到当前节点数，各层都停下，也不记无杀备忘 */
+static bool vcf_exhausted(GmkSearch *s) {
+  if (s->vcf_nodes >= s->vcf_limit) return true;
+  if (s->deadline && (s->vcf_nodes % GMK_CLOCK_CHECK_NODES) == 0 && game_clock_us() >= s->deadline) {
+    s->vcf_limit = s->vcf_nodes;
+    return true;
   }
   return false;
 }
 
-/* 若对方在此落子会成五，则 (r,c) 为必防点；返回是否找到唯一防点并写入 *out_r,*out_c */
-static bool must_block(const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE], int *out_r, int *out_c) {
-  int block_r = -1, block_c = -1;
-  int count = 0;
-  for (int r = 0; r < GOMOKU_SIZE; r++) {
-    for (int c = 0; c < GOMOKU_SIZE; c++) {
-      if (b[r][c] != 0) continue;
-      if (would_win(b, r, c, HU_PLAYER)) {
-        if (count == 0) { block_r = r; block_c = c; }
-        count++;
+/* att 先走，depth 手内能否连续冲四取胜；out_cell 非空时写入第一手（r*15+c），并且不查备忘 */
+static bool vcf_search(GmkSearch *s, uint8_t att, int depth, int *out_cell) {
+  uint8_t def = (uint8_t)(3 - att);
+  int r = 0, c = 0;
+  if (gmk_search_first_threat(s, att, THREAT_FIVE, &r, &c)) {
+    if (out_cell) *out_cell = r * GOMOKU_SIZE + c;
+    return true;
+  }
+  int def_fives = s->threat_cells[def - 1][THREAT_FIVE];
+  if (depth <= 0 || def_fives >= 2 || vcf_exhausted(s)) return false;
+
+  uint64_t key = s->keys[0] ^ (att == AI_PLAYER ? s_zobrist_side : 0);
+  GmkVcfMemo *m = &s->ai->vcf_memo[key & ((1u << GMK_VCF_MEMO_BITS) - 1)];
+  uint32_t check = (uint32_t)(key >> 32);
+  if (!out_cell && m->check == check && (m->win || m->depth >= depth)) return m->win;
+
+  /* 对方已有一处成五点：只能走这一点，且它本身也得成四 */
+  uint16_t rows[GOMOKU_SIZE];
+  memcpy(rows, s->threat_rows[att - 1][THREAT_FOUR], sizeof(rows));
+  if (def_fives == 1) {
+    gmk_search_first_threat(s, def, THREAT_FIVE, &r, &c);
+    uint16_t only = (uint16_t)(rows[r] & (1u << c));
+    memset(rows, 0, sizeof(rows));
+    rows[r] = only;
+  }
+
+  bool win = false;
+  for (r = 0; r < GOMOKU_SIZE && !win; r++) {
+    for (uint16_t row = rows[r]; row && !win && !vcf_exhausted(s); row &= (uint16_t)(row - 1)) {
+      c = __builtin_ctz(row);
+      s->vcf_nodes++;
+      GmkUndo ua, ud;
+      gmk_search_make(s, r, c, att, &ua);
+      int br, bc;
+      if (s->threat_cells[att - 1][THREAT_FIVE] >= 2) {
+        win = true;                        /* 活四或双四：挡不住 */
+      } else if (gmk_search_first_threat(s, att, THREAT_FIVE, &br, &bc)) {
+        gmk_search_make(s, br, bc, def, &ud);
+        win = vcf_search(s, att, depth - 1, NULL);
+        gmk_search_unmake(s, br, bc, &ud);
       }
+      gmk_search_unmake(s, r, c, &ua);
+      if (win && out_cell) *out_cell = r * GOMOKU_SIZE + c;
     }
   }
-  if (count == 0) return false;
-  *out_r = block_r; *out_c = block_c;
-  return true;
+  if (win || s->vcf_nodes < s->vcf_limit) {
+    m->check = check;
+    m->depth = (uint8_t)depth;
+    m->win = win;
+  }
+  return win;
+}
+
+/* 一次求解，节点数以 GMK_VCF_NODES 为限；有时间预算且已到点时直接按无杀返回 */
+static bool vcf_solve(GmkSearch *s, uint8_t att, int *out_cell) {
+  if (s->deadline && game_clock_us() >= s->deadline) return false;
+  s->vcf_limit = s->vcf_nodes + GMK_VCF_NODES;
+  return vcf_search(s, att, GMK_VCF_DEPTH, out_cell);
 }
 
 /* ---------- Alpha-Beta 搜索（只扩展候选步） ---------- */
-static int alphabeta(uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE], int depth, int alpha, int beta, bool maximizing) {
-  int ev = evaluate(b);
+static int alphabeta(GmkSearch *s, int depth, int ply, int alpha, int beta, bool maximizing) {
+  s->nodes++;
+  if (s->deadline && (s->nodes % GMK_CLOCK_CHECK_NODES) == 0 && game_clock_us() >= s->deadline)
+    s->aborted = true;
+  if (s->aborted) return 0;
+  int ev = gmk_search_evaluate(s);
   if (ev >= SCORE_WIN - 1000 || ev <= SCORE_LOSS + 1000) return ev;
+  /* 查威胁索引：轮到的一方能一步成五即胜；对方有两处成五点则挡不住，只有一处则只能挡那里 */
+  uint8_t me = maximizing ? AI_PLAYER : HU_PLAYER, opp = (uint8_t)(3 - me);
+  if (s->threat_cells[me - 1][THREAT_FIVE]) return maximizing ? SCORE_WIN : SCORE_LOSS;
+  int forced = s->threat_cells[opp - 1][THREAT_FIVE];
+  if (forced >= 2) return maximizing ? SCORE_LOSS : SCORE_WIN;
   if (depth <= 0) return ev;
 
-  Candidate cand[MAX_CANDIDATES];
-  int n = collect_candidates(b, cand, MAX_CANDIDATES, maximizing);
+  /* 置换表：够深且界限可用则直接返回，否则取其最佳着法排在最前 */
+  int sym;
+  uint64_t key = tt_key(s, maximizing, &sym);
+  GmkTTEntry e;
+  int hash_cell = -1;
+  if (tt_probe(s, key, &e)) {
+    if (e.depth >= depth &&
+        (e.bound == TT_EXACT || (e.bound == TT_LOWER && e.score >= beta) ||
+         (e.bound == TT_UPPER && e.score <= alpha))) {
+      s->tt_cuts++;
+      return e.score;
+    }
+    if (e.best != 0xFF) hash_cell = sym_unmap(sym, e.best);
+  }
+  int alpha0 = alpha, beta0 = beta;
+
+  Candidate cand[GMK_MAX_CANDIDATES];
+  int n;
+  if (forced) {
+    gmk_search_first_threat(s, opp, THREAT_FIVE, &cand[0].r, &cand[0].c);
+    cand[0].score = 0;
+    n = 1;
+  } else {
+    n = collect_candidates(s, cand, GMK_MAX_CANDIDATES, me, hash_cell, ply);
+#if GOMOKU_POLICY
+    if (s->policy_k && n > s->policy_k) n = policy_prune(s, cand, n, me, ply);
+#endif
+  }
   if (n == 0) return ev;
 
-  if (maximizing) {
-    sort_candidates_max(cand, n);
-    int value = SCORE_LOSS;
-    for (int i = 0; i < n; i++) {
-      int r = cand[i].r, c = cand[i].c;
-      b[r][c] = AI_PLAYER;
-      int s = alphabeta(b, depth - 1, alpha, beta, false);
-      b[r][c] = 0;
-      if (s > value) value = s;
-      if (value > alpha) alpha = value;
-      if (beta <= alpha) return value;
+  int value = maximizing ? SCORE_LOSS : SCORE_WIN;
+  int best = 0;
+  for (int i = 0; i < n; i++) {
+    pick_candidate(cand, i, n);
+    int r = cand[i].r, c = cand[i].c;
+    GmkUndo u;
+    gmk_search_make(s, r, c, me, &u);
+    int v = alphabeta(s, depth - 1, ply + 1, alpha, beta, !maximizing);
+    gmk_search_unmake(s, r, c, &u);
+    if (s->aborted) return 0;              /* 不完整的结果不写置换表 */
+    if (maximizing ? v > value : v < value) { value = v; best = i; }
+    if (maximizing) { if (value > alpha) alpha = value; }
+    else if (value < beta) beta = value;
+    if (beta <= alpha) {
+      if (!forced) note_cutoff(s, r, c, me, depth, ply);
+      break;
     }
-    return value;
+  }
+  int bound = value <= alpha0 ? TT_UPPER : value >= beta0 ? TT_LOWER : TT_EXACT;
+  tt_store(s, key, depth, value, bound, sym_map(sym, cand[best].r, cand[best].c));
+  return value;
+}
+
+/* ---------- 根节点并行：首个候选单独搜出 alpha，其余候选经偷活队列分给各 worker ---------- */
+typedef struct {
+  GmkSearch *pos[GMK_MAX_WORKERS];     /* 各 worker 的局面；pos[0] 为调用者的 */
+  const Candidate *cand;
+  const bool *lost;
+  int depth;
+  int workers;
+  /* 每个 worker 一个双端队列（候选下标）：自己从头取，即排序靠前的先搜；空了从别人的尾部偷排序最靠后的 */
+  int8_t queue[GMK_MAX_WORKERS][GMK_MAX_CANDIDATES];
+  int head[GMK_MAX_WORKERS], tail[GMK_MAX_WORKERS];
+  int score[GMK_MAX_CANDIDATES];
+  int best_score;                      /* 共享的 alpha：已搜完的根着法中的最高分 */
+  bool aborted;
+} GmkRootSplit;
+
+/* 以 (alpha, SCORE_WIN) 搜一个根着法：分数 <= alpha 时只是上界，不会被选中 */
+static int root_search_move(GmkSearch *s, const Candidate *c, bool lost, int depth, int alpha) {
+  GmkUndo u;
+  gmk_search_make(s, c->r, c->c, AI_PLAYER, &u);
+  int v = lost ? SCORE_LOSS + 1 : alphabeta(s, depth - 1, 1, alpha, SCORE_WIN, false);
+  gmk_search_unmake(s, c->r, c->c, &u);
+  return v;
+}
+
+static int root_take(GmkRootSplit *job, int w) {
+  int i = -1;
+  gmk_par_lock();
+  if (job->head[w] < job->tail[w]) {
+    i = job->queue[w][job->head[w]++];
   } else {
-    sort_candidates_min(cand, n);
-    int value = SCORE_WIN;
-    for (int i = 0; i < n; i++) {
-      int r = cand[i].r, c = cand[i].c;
-      b[r][c] = HU_PLAYER;
-      int s = alphabeta(b, depth - 1, alpha, beta, true);
-      b[r][c] = 0;
-      if (s < value) value = s;
-      if (value < beta) beta = value;
-      if (beta <= alpha) return value;
+    for (int k = 1; k < job->workers && i < 0; k++) {
+      int v = (w + k) % job->workers;
+      if (job->head[v] < job->tail[v]) i = job->queue[v][--job->tail[v]];
+    }
+  }
+  gmk_par_unlock();
+  return i;
+}
+
+static void root_worker(void *arg, int w) {
+  GmkRootSplit *job = arg;
+  GmkSearch *s = job->pos[w];
+  for (int i; (i = root_take(job, w)) >= 0;) {
+    gmk_par_lock();
+    int alpha = job->best_score - 1;   /* 减 1：与当前最高分同分的着法也得到准确分，平手时仍按排序先者 */
+    bool stop = job->aborted;
+    gmk_par_unlock();
+    if (stop) break;
+    int v = root_search_move(s, &job->cand[i], job->lost[i], job->depth, alpha);
+    gmk_par_lock();
+    if (s->aborted) {
+      job->aborted = true;
+    } else {
+      job->score[i] = v;
+      if (v > job->best_score) job->best_score = v;
     }
-    return value;
+    gmk_par_unlock();
+    if (s->aborted) break;
   }
 }
 
-void gmk_game_init(GmkGameState *g) {
+/* 搜完一层的全部根着法，返回最佳着法的下标（同分取排序靠前者）并写入其分数；超时返回 -1。
+ * 另外 workers - 1 个 worker 用 AI 上下文里预留的局面，搜之前从 s 复制（带上杀手、历史表），搜完把统计加回 s */
+static int root_search(GmkSearch *s, int workers, const Candidate *cand, const bool *lost,
+                       int n, int depth, int *best_score, uint8_t *used) {
+  static GmkRootSplit job;
+  int first = root_search_move(s, &cand[0], lost[0], depth, SCORE_LOSS - 1);
+  if (s->aborted) return -1;
+  *best_score = first;
+  if (n == 1) return 0;
+  if (workers > n - 1) workers = n - 1;
+  job.pos[0] = s;
+  for (int w = 1; w < workers; w++) {
+    GmkSearch *ws = &s->ai->worker_pos[w - 1];
+    memcpy(ws, s, sizeof(*ws));
+    ws->nodes = ws->gen_us = 0;
+    ws->tt_probes = ws->tt_hits = ws->tt_cuts = 0;
+    job.pos[w] = ws;
+  }
+  job.cand = cand;
+  job.lost = lost;
+  job.depth = depth;
+  job.workers = workers;
+  for (int w = 0; w < workers; w++) job.head[w] = job.tail[w] = 0;
+  for (int i = 1; i < n; i++) {
+    int w = (i - 1) % workers;
+    job.queue[w][job.tail[w]++] = (int8_t)i;
+  }
+  job.score[0] = first;
+  job.best_score = first;
+  job.aborted = false;
+  int ran = gmk_par_run(workers, root_worker, &job, s->ai->par_stack);
+  if (ran > *used) *used = (uint8_t)ran;
+  for (int w = 1; w < workers; w++) {
+    const GmkSearch *ws = job.pos[w];
+    s->nodes += ws->nodes;
+    s->gen_us += ws->gen_us;
+    s->tt_probes += ws->tt_probes;
+    s->tt_hits += ws->tt_hits;
+    s->tt_cuts += ws->tt_cuts;
+  }
+  if (job.aborted) {
+    s->aborted = true;
+    return -1;
+  }
+  int best = 0;
+  for (int i = 1; i < n; i++)
+    if (job.score[i] > job.score[best]) best = i;
+  *best_score = job.score[best];
+  return best;
+}
+
+void gmk_game_init(GmkGameState *g, GmkAiContext *ai) {
   memset(g->board, 0, sizeof(g->board));
   g->cur_player = HU_PLAYER;
   g->game_over = false;
   g->has_win_line = false;
+  g->ai_depth = AI_DEPTH;
+  g->ai_budget_ms = 0;
+  g->ai_engine = GMK_ENGINE_ALPHABETA;
+  g->ai_playouts = GMK_MCTS_PLAYOUTS;
+#if GOMOKU_POLICY
+  g->ai_policy_k = GMK_POLICY_TOP_K;
+#else
+  g->ai_policy_k = 0;
+#endif
+  g->ai_workers = (uint8_t)(ai ? ai->workers : 1);
+  memset(&g->last_stats, 0, sizeof(g->last_stats));
+  g->ai = ai;
+  if (ai) {
+    memset(ai->tt, 0, sizeof(ai->tt));
+    memset(ai->vcf_memo, 0, sizeof(ai->vcf_memo));
+  }
+}
+
+void gmk_game_set_level(GmkGameState *g, GmkLevel level) {
+  static const struct { uint8_t depth; uint16_t budget_ms; uint8_t engine; } levels[GMK_LEVEL_COUNT] = {
+    { 2, 0, GMK_ENGINE_ALPHABETA }, { AI_DEPTH, 0, GMK_ENGINE_ALPHABETA },
+    { 8, 1000, GMK_ENGINE_ALPHABETA }, { 10, 3000, GMK_ENGINE_ALPHABETA },
+    { AI_DEPTH, 3000, GMK_ENGINE_MCTS },
+  };
+  if ((unsigned)level >= GMK_LEVEL_COUNT) level = GMK_LEVEL_NORMAL;
+  g->ai_depth = levels[level].depth;
+  g->ai_budget_ms = levels[level].budget_ms;
+  g->ai_engine = levels[level].engine;
+  g->ai_playouts = GMK_MCTS_PLAYOUTS;
 }
 
 bool gmk_game_place_human(GmkGameState *g, int row, int col) {
@@ -297,66 +916,127 @@ bool gmk_game_place_human(GmkGameState *g, int row, int col) {
   return true;
 }
 
+/* AI 在 (r,c) 落子并判定胜负/和棋 */
+static bool ai_place(GmkGameState *g, int r, int c, int *out_r, int *out_c) {
+  g->board[r][c] = AI_PLAYER;
+  if (out_r) *out_r = r;
+  if (out_c) *out_c = c;
+  if (check_win_at(g, r, c, AI_PLAYER)) g->game_over = true;
+  else if (is_draw(g)) g->game_over = true;
+  else g->cur_player = HU_PLAYER;
+  return true;
+}
+
+static void finish_stats(GmkGameState *g, const GmkSearch *s, uint64_t t0) {
+  g->last_stats.nodes = s->nodes;
+  g->last_stats.gen_us = s->gen_us;
+  g->last_stats.tt_probes = s->tt_probes;
+  g->last_stats.tt_hits = s->tt_hits;
+  g->last_stats.tt_cuts = s->tt_cuts;
+  g->last_stats.vcf_nodes = s->vcf_nodes;
+  g->last_stats.elapsed_us = (uint32_t)(game_clock_us() - t0);
+}
+
 bool gmk_game_ai_move(GmkGameState *g, int *out_r, int *out_c) {
-  if (g->game_over || g->cur_player != AI_PLAYER) return false;
+  if (g->game_over || g->cur_player != AI_PLAYER || !g->ai) return false;
 
-  uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE];
-  memcpy(b, g->board, sizeof(b));
+  GmkSearch *search = &g->ai->search;
+  uint64_t t0 = game_clock_us();
+  gmk_search_init(search, g->board);
+  search->policy_k = g->ai_policy_k;
+  search->ai = g->ai;
+  /* 有时间预算时从 VCF 起就计时：根节点每个候选各做一次 VCF 防守求解，最多 64 × GMK_VCF_NODES 个节点 */
+  uint64_t budget_us = (uint64_t)g->ai_budget_ms * 1000u;
+  search->deadline = budget_us ? t0 + budget_us : 0;
+  memset(&g->last_stats, 0, sizeof(g->last_stats));
+  g->last_stats.engine = g->ai_engine;
+  g->last_stats.workers = 1;   /* MCTS、VCF、必杀必防都只在当前核上算 */
 
-  /* 1) 必杀：有一步成五则直接下 */
-  for (int r = 0; r < GOMOKU_SIZE; r++) {
-    for (int c = 0; c < GOMOKU_SIZE; c++) {
-      if (b[r][c] != 0) continue;
-      if (would_win(b, r, c, AI_PLAYER)) {
-        g->board[r][c] = AI_PLAYER;
-        if (out_r) *out_r = r; if (out_c) *out_c = c;
-        if (check_win_at(g, r, c, AI_PLAYER)) g->game_over = true;
-        else if (is_draw(g)) g->game_over = true;
-        else g->cur_player = HU_PLAYER;
-        return true;
+  /* 1) 必杀：有一步成五则直接下（查威胁索引） */
+  int win_r, win_c;
+  if (gmk_search_first_threat(search, AI_PLAYER, THREAT_FIVE, &win_r, &win_c))
+    return ai_place(g, win_r, win_c, out_r, out_c);
+
+  /* 2) 必防：对方有活四/冲四（一步成五的点）则防 */
+  int block_r, block_c;
+  if (gmk_search_first_threat(search, HU_PLAYER, THREAT_FIVE, &block_r, &block_c))
+    return ai_place(g, block_r, block_c, out_r, out_c);
+
+  /* 3) VCF 进攻：有连续冲四的杀则走第一手 */
+  int cell;
+  if (vcf_solve(search, AI_PLAYER, &cell)) {
+    finish_stats(g, search, t0);
+    return ai_place(g, cell / GOMOKU_SIZE, cell % GOMOKU_SIZE, out_r, out_c);
+  }
+  /* 4) MCTS：节点池随上下文预留（gmk_ai_context_new）；没有池或没走出着法时退回 Alpha-Beta，last_stats.engine 记实际用的引擎 */
+  if (g->ai_engine == GMK_ENGINE_MCTS) {
+    GmkMcts *mcts = g->ai->mcts;
+    g->last_stats.engine = GMK_ENGINE_ALPHABETA;
+    if (mcts) {
+      gmk_mcts_init(mcts, g->board, (uint32_t)search->keys[0] | 1u);
+      uint64_t deadline = g->ai_budget_ms ? t0 + (uint64_t)g->ai_budget_ms * 1000u : 0;
+      g->last_stats.playouts = gmk_mcts_run(mcts, g->ai_playouts ? g->ai_playouts : GMK_MCTS_PLAYOUTS, deadline);
+      cell = gmk_mcts_best(mcts);
+      if (cell >= 0) {
+        g->last_stats.engine = GMK_ENGINE_MCTS;
+        finish_stats(g, search, t0);
+        return ai_place(g, cell / GOMOKU_SIZE, cell % GOMOKU_SIZE, out_r, out_c);
       }
     }
   }
+  /* 5) Alpha-Beta 搜索 */
+  Candidate cand[GMK_MAX_CANDIDATES];
+  int n = collect_candidates(search, cand, GMK_MAX_CANDIDATES, AI_PLAYER, -1, 0);
+  if (n == 0) return false;
+  /* 根节点每个候选都要搜，仍按试落子后的整盘评估一次排好：同分时先搜到的胜出，整盘评估是更好的平手裁决 */
+  for (int i = 0; i < n; i++) {
+    GmkUndo u;
+    place_stone(search, cand[i].r, cand[i].c, AI_PLAYER, &u);
+    cand[i].score = gmk_search_evaluate(search);
+    remove_stone(search, cand[i].r, cand[i].c, &u);
+  }
+  for (int i = 0; i < n; i++) pick_candidate(cand, i, n);
 
-  /* 2) 必防：对方有活四/冲四则防 */
-  int block_r, block_c;
-  if (must_block(b, &block_r, &block_c) &&
-      (unsigned)block_r < GOMOKU_SIZE && (unsigned)block_c < GOMOKU_SIZE) {
-    g->board[block_r][block_c] = AI_PLAYER;
-    if (out_r) *out_r = block_r; if (out_c) *out_c = block_c;
-    if (check_win_at(g, block_r, block_c, AI_PLAYER)) g->game_over = true;
-    else if (is_draw(g)) g->game_over = true;
-    else g->cur_player = HU_PLAYER;
-    return true;
+  /* VCF 防守：对方现在就有连续冲四的杀时，走完后对方仍有杀的着法按输棋计（各层共用）；
+   * 预算用完时余下的候选不再求解，当作未输 */
+  bool lost[GMK_MAX_CANDIDATES] = { false };
+  if (vcf_solve(search, HU_PLAYER, NULL)) {
+    for (int i = 0; i < n; i++) {
+      GmkUndo u;
+      gmk_search_make(search, cand[i].r, cand[i].c, AI_PLAYER, &u);
+      lost[i] = vcf_solve(search, HU_PLAYER, NULL);
+      gmk_search_unmake(search, cand[i].r, cand[i].c, &u);
+    }
   }
 
-  /* 3) Alpha-Beta 搜索 */
-  Candidate cand[MAX_CANDIDATES];
-  int n = collect_candidates(b, cand, MAX_CANDIDATES, true);
-  if (n == 0) return false;
+  /* 无预算时只搜 ai_depth 一层；有预算时从 1 层起加深，第一层不计时，保证总有着法。
+   * 每层搜完把最佳着法排到最前，超时则丢弃没搜完的一层 */
+  /* 根节点并行：至多用到上下文预留的 worker 数 */
+  int workers = g->ai_workers < 1 ? 1 : g->ai_workers > g->ai->workers ? g->ai->workers : g->ai_workers;
 
-  sort_candidates_max(cand, n);
   int best_r = cand[0].r, best_c = cand[0].c;
-  int best_score = SCORE_LOSS;
-
-  for (int i = 0; i < n; i++) {
-    int r = cand[i].r, c = cand[i].c;
-    b[r][c] = AI_PLAYER;
-    int s = alphabeta(b, AI_DEPTH - 1, SCORE_LOSS, SCORE_WIN, false);
-    b[r][c] = 0;
-    if (s > best_score) {
-      best_score = s;
-      best_r = r;
-      best_c = c;
-    }
+  int max_depth = g->ai_depth < 1 ? 1 : g->ai_depth;
+  int first = g->ai_budget_ms ? 1 : max_depth;
+  for (int depth = first; depth <= max_depth; depth++) {
+    search->deadline = (g->ai_budget_ms && depth > first) ? t0 + budget_us : 0;
+    int best_score;
+    int best = root_search(search, workers, cand, lost, n, depth, &best_score, &g->last_stats.workers);
+    if (best < 0) break;
+    best_r = cand[best].r;
+    best_c = cand[best].c;
+    g->last_stats.depth = (uint8_t)depth;
+    Candidate top = cand[best];
+    bool top_lost = lost[best];
+    memmove(&cand[1], &cand[0], (size_t)best * sizeof(cand[0]));
+    memmove(&lost[1], &lost[0], (size_t)best * sizeof(lost[0]));
+    cand[0] = top;
+    lost[0] = top_lost;
+    if (best_score >= SCORE_WIN - 1000) break;                     /* 已找到杀 */
+    if (budget_us && game_clock_us() - t0 > budget_us / 2) break;   /* 下一层多半搜不完 */
   }
 
-  g->board[best_r][best_c] = AI_PLAYER;
-  if (out_r) *out_r = best_r; if (out_c) *out_c = best_c;
-  if (check_win_at(g, best_r, best_c, AI_PLAYER)) g->game_over = true;
-  else if (is_draw(g)) g->game_over = true;
-  else g->cur_player = HU_PLAYER;
-  return true;
+  finish_stats(g, search, t0);
+  return ai_place(g, best_r, best_c, out_r, out_c);
 }
 
 bool gmk_game_is_over(const GmkGameState *g) {
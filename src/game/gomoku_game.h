@@ -2,19 +2,84 @@
 #define PICO_CODE_GOMOKU_GAME_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #define GOMOKU_SIZE 15
 
+/* 根节点并行的 worker 数：Pico 上用上 core1；主机上默认单线程（gomoku_bench -j 可改），可在编译时覆盖 */
+#ifndef GMK_WORKERS
+#if defined(PICO_ON_DEVICE)
+#define GMK_WORKERS 2
+#else
+#define GMK_WORKERS 1
+#endif
+#endif
+
+/* 上一次 gmk_game_ai_move 的搜索统计（必杀/必防直接落子时为 0；VCF 找到杀时只有 vcf_nodes 与耗时） */
+typedef struct {
+  uint32_t nodes;        /* alphabeta 访问的节点数 */
+  uint32_t elapsed_us;
+  uint32_t gen_us;       /* 其中候选生成（含候选打分）的耗时 */
+  uint32_t tt_probes;    /* 置换表查询次数、键命中次数、直接截断（不再搜索）次数 */
+  uint32_t tt_hits;
+  uint32_t tt_cuts;
+  uint32_t vcf_nodes;    /* VCF（连续冲四）求解的节点数 */
+  uint8_t depth;         /* 完整搜完的最深层数 */
+  uint32_t playouts;     /* MCTS 引擎做的模拟次数 */
+  uint8_t engine;        /* 实际用的引擎（GmkEngine）：MCTS 档没有节点池或没走出着法时退回 Alpha-Beta */
+  uint8_t workers;       /* 根节点并行实际用到的 worker 数；没走到 Alpha-Beta 根搜索时为 1 */
+} GmkSearchStats;
+
+/* 搜索引擎：默认 Alpha-Beta；MCTS 为 gomoku_mcts.c 的 UCT 树搜索，用 ai_budget_ms 与 ai_playouts 限额 */
+typedef enum {
+  GMK_ENGINE_ALPHABETA = 0,
+  GMK_ENGINE_MCTS,
+} GmkEngine;
+
+/* AI 的工作内存（置换表、VCF 备忘、根局面，MCTS 档另有节点池，根节点并行另有 worker 局面与栈，定义在 gomoku_game.c）：
+ * 约 38KB（MCTS 档 +21KB；Pico 上 core1 作第二个 worker 时 +21KB），不放静态区；
+ * 进入五子棋时用 gmk_ai_context_new 分配，退出时用 gmk_ai_context_free 释放 */
+typedef struct GmkAiContext GmkAiContext;
+
 typedef struct {
   uint8_t board[GOMOKU_SIZE][GOMOKU_SIZE];
   uint8_t cur_player;
   bool game_over;
   int win_r0, win_c0, win_r1, win_c1;
   bool has_win_line;
+  uint8_t ai_depth;      /* 搜索层数（有时间预算时为迭代加深的上限），gmk_game_init 设为默认 3 */
+  uint16_t ai_budget_ms; /* 0：固定 ai_depth 层；否则迭代加深，用完预算即返回已搜完的最深一层 */
+  uint8_t ai_engine;     /* GmkEngine */
+  uint32_t ai_playouts;  /* MCTS 每步的模拟次数上限（与 ai_budget_ms 先到者为准） */
+  uint8_t ai_policy_k;   /* Alpha-Beta 内部节点只展开策略网络分最高的 k 个候选；0 = 不剪。
+                          * 以 GOMOKU_POLICY 编译时 gmk_game_init 设为 GMK_POLICY_TOP_K，否则为 0 且不起作用 */
+  uint8_t ai_workers;    /* Alpha-Beta 根节点并行的 worker 数（gomoku_par.h）：Pico 上 2 = core0 + core1，主机上为线程数；
+                          * gmk_game_init 设为上下文预留的数目，只能调小 */
+  GmkSearchStats last_stats;
+  GmkAiContext *ai;      /* gmk_game_init 挂上；为 NULL 时 gmk_game_ai_move 不走子 */
 } GmkGameState;
 
-void gmk_game_init(GmkGameState *g);
+/* 难度：前两档固定层数，中间两档按时间预算迭代加深，最后一档改用 MCTS */
+typedef enum {
+  GMK_LEVEL_EASY = 0,    /* 2 层 */
+  GMK_LEVEL_NORMAL,      /* 3 层（gmk_game_init 的默认） */
+  GMK_LEVEL_HARD,        /* 1 秒，最多 8 层 */
+  GMK_LEVEL_EXPERT,      /* 3 秒，最多 10 层 */
+  GMK_LEVEL_MCTS,        /* MCTS，3 秒或 GMK_MCTS_PLAYOUTS 次模拟 */
+  GMK_LEVEL_COUNT
+} GmkLevel;
+
+/* 分配 AI 上下文，失败返回 NULL；mcts 为 true 时一并预留 MCTS 的节点池（选了 GMK_LEVEL_MCTS 时用），
+ * workers 为根节点并行的 worker 数上限（GMK_WORKERS：Pico 上 2，主机上 1），预留其局面与栈。大小见 gmk_ai_context_size */
+GmkAiContext *gmk_ai_context_new(bool mcts, int workers);
+void gmk_ai_context_free(GmkAiContext *ai);
+size_t gmk_ai_context_size(bool mcts, int workers);
+
+/* 新对局：ai 为本局 AI 使用的上下文（其中的置换表与 VCF 备忘一并清空） */
+void gmk_game_init(GmkGameState *g, GmkAiContext *ai);
+/* 设置 ai_depth / ai_budget_ms / ai_engine / ai_playouts；gmk_game_init 会恢复为 GMK_LEVEL_NORMAL */
+void gmk_game_set_level(GmkGameState *g, GmkLevel level);
 bool gmk_game_place_human(GmkGameState *g, int row, int col);
 /* out_r, out_c: optional; when non-NULL, set to AI-placed cell for UI (e.g. blink) */
 bool gmk_game_ai_move(GmkGameState *g, int *out_r, int *out_c);
@@ -0,0 +1,214 @@
+/**
+ * @file gomoku_mcts.c
+ */
+
+#include <math.h>
+#include <string.h>
+#include "game/game_clock.h"
+#include "game/gomoku_mcts.h"
+
+/* UCT 探索系数（胜率在 0..1） */
+#define MCTS_UCT_C        0.7f
+/* 展开前叶子至少要被模拟过的次数（根除外），省节点池 */
+#define MCTS_EXPAND_VISITS 2
+/* 模拟中每步随机取几个候选，走其中局部棋型分最高的 */
+#define MCTS_ROLLOUT_SAMPLES 3
+/* 每隔多少次模拟看一次钟 */
+#define MCTS_CLOCK_CHECK   16
+
+static uint32_t mcts_rand(GmkMcts *m) {
+  uint32_t x = m->rng;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  m->rng = x;
+  return x;
+}
+
+void gmk_mcts_init(GmkMcts *m, const uint8_t board[GOMOKU_SIZE][GOMOKU_SIZE], uint32_t seed) {
+  gmk_search_init(&m->pos, board);
+  memset(&m->nodes[0], 0, sizeof(m->nodes[0]));
+  m->used = 1;
+  m->rng = seed ? seed : 1;
+  m->playouts = 0;
+}
+
+static int count_candidates(const GmkSearch *s) {
+  int n = 0;
+  for (int r = 0; r < GOMOKU_SIZE; r++) n += __builtin_popcount(s->cand_rows[r]);
+  return n;
+}
+
+/* 第 k 个候选格（行优先） */
+static int nth_candidate(const GmkSearch *s, int k) {
+  for (int r = 0; r < GOMOKU_SIZE; r++) {
+    int cnt = __builtin_popcount(s->cand_rows[r]);
+    if (k >= cnt) { k -= cnt; continue; }
+    uint16_t row = s->cand_rows[r];
+    while (k-- > 0) row &= (uint16_t)(row - 1);
+    return r * GOMOKU_SIZE + __builtin_ctz(row);
+  }
+  return -1;
+}
+
+/* 轮到 p 时已分胜负：p 有成五点则 p 胜，对方有两处成五点则对方胜；返回胜方，未分返回 0 */
+static uint8_t decided(const GmkSearch *s, uint8_t p) {
+  int r, c;
+  if (gmk_search_first_threat(s, p, THREAT_FIVE, &r, &c)) return p;
+  if (s->threat_cells[2 - p][THREAT_FIVE] >= 2) return (uint8_t)(3 - p);
+  return 0;
+}
+
+/* 展开：对方有成五点时只有挡点；否则取局部棋型分最高的 GMK_MCTS_WIDTH 个候选，按分从高到低存放。池满返回 false */
+static bool expand(GmkMcts *m, GmkMctsNode *node, uint8_t p) {
+  const GmkSearch *s = &m->pos;
+  int cells[GOMOKU_SIZE * GOMOKU_SIZE], scores[GOMOKU_SIZE * GOMOKU_SIZE];
+  int n = 0, r, c;
+  if (gmk_search_first_threat(s, (uint8_t)(3 - p), THREAT_FIVE, &r, &c)) {
+    cells[n++] = r * GOMOKU_SIZE + c;
+  } else if (s->stones == 0) {
+    cells[n++] = (GOMOKU_SIZE / 2) * (GOMOKU_SIZE + 1);
+  } else {
+    for (r = 0; r < GOMOKU_SIZE; r++)
+      for (uint16_t row = s->cand_rows[r]; row; row &= (uint16_t)(row - 1)) {
+        c = __builtin_ctz(row);
+        cells[n] = r * GOMOKU_SIZE + c;
+        scores[n++] = gmk_search_cell_score(s, r, c, p);
+      }
+    /* 部分选择排序，只排出前 GMK_MCTS_WIDTH 个 */
+    int keep = n < GMK_MCTS_WIDTH ? n : GMK_MCTS_WIDTH;
+    for (int i = 0; i < keep; i++) {
+      int best = i;
+      for (int j = i + 1; j < n; j++)
+        if (scores[j] > scores[best]) best = j;
+      int tc = cells[i], ts = scores[i];
+      cells[i] = cells[best]; scores[i] = scores[best];
+      cells[best] = tc; scores[best] = ts;
+    }
+    n = keep;
+  }
+  if (n == 0 || m->used + (uint32_t)n > GMK_MCTS_NODES) return false;
+  node->first_child = (uint16_t)m->used;
+  node->n_children = (uint8_t)n;
+  for (int i = 0; i < n; i++) {
+    GmkMctsNode *ch = &m->nodes[m->used++];
+    memset(ch, 0, sizeof(*ch));
+    ch->cell = (uint8_t)cells[i];
+  }
+  return true;
+}
+
+/* UCT 选子：没模拟过的子按展开顺序（棋型分高者）先试 */
+static GmkMctsNode *select_child(GmkMcts *m, const GmkMctsNode *node) {
+  GmkMctsNode *ch = &m->nodes[node->first_child];
+  float log_n = logf((float)node->visits);
+  GmkMctsNode *best = ch;
+  float best_v = -1.0f;
+  for (int i = 0; i < node->n_children; i++) {
+    if (ch[i].visits == 0) return &ch[i];
+    float v = (float)ch[i].wins2 / (2.0f * (float)ch[i].visits) +
+              MCTS_UCT_C * sqrtf(log_n / (float)ch[i].visits);
+    if (v > best_v) { best_v = v; best = &ch[i]; }
+  }
+  return best;
+}
+
+/* 从当前局面（轮到 p）快速模拟，走子记在 m->undo[ply..]；返回胜方，0 为和。
+ * 能成五就成五、对方有成五点就挡，否则随机抽几个候选走其中棋型分最高的；走满 GMK_MCTS_ROLLOUT_PLIES 手按评估定胜负 */
+static uint8_t rollout(GmkMcts *m, uint8_t p, int *ply) {
+  GmkSearch *s = &m->pos;
+  for (int i = 0; i < GMK_MCTS_ROLLOUT_PLIES; i++) {
+    uint8_t w = decided(s, p);
+    if (w) return w;
+    int r, c, cell = -1;
+    if (gmk_search_first_threat(s, (uint8_t)(3 - p), THREAT_FIVE, &r, &c)) {
+      cell = r * GOMOKU_SIZE + c;
+    } else {
+      int n = count_candidates(s);
+      if (n == 0) return 0;
+      int best_score = -1;
+      for (int k = 0; k < MCTS_ROLLOUT_SAMPLES; k++) {
+        int x = nth_candidate(s, (int)(mcts_rand(m) % (uint32_t)n));
+        int sc = gmk_search_cell_score(s, x / GOMOKU_SIZE, x % GOMOKU_SIZE, p);
+        if (sc > best_score) { best_score = sc; cell = x; }
+      }
+    }
+    m->moves[*ply] = (uint8_t)cell;
+    gmk_search_make(s, cell / GOMOKU_SIZE, cell % GOMOKU_SIZE, p, &m->undo[*ply]);
+    (*ply)++;
+    p = (uint8_t)(3 - p);
+  }
+  int ev = gmk_search_evaluate(s);
+  if (ev > SCORE_LIVE3) return AI_PLAYER;
+  if (ev < -SCORE_LIVE3) return HU_PLAYER;
+  return 0;
+}
+
+static void playout(GmkMcts *m) {
+  GmkMctsNode *path[GMK_MCTS_MAX_DEPTH + 1];
+  GmkMctsNode *node = &m->nodes[0];
+  uint8_t p = AI_PLAYER, winner = 0;
+  int depth = 0, ply = 0;
+  bool done = false;
+  path[0] = node;
+  /* 选择：沿 UCT 下到叶子，够格时展开 */
+  while (depth < GMK_MCTS_MAX_DEPTH) {
+    winner = decided(&m->pos, p);
+    if (winner) { done = true; break; }
+    if (node->first_child == 0) {
+      if (depth > 0 && node->visits < MCTS_EXPAND_VISITS) break;
+      if (!expand(m, node, p)) break;
+    }
+    node = select_child(m, node);
+    m->moves[ply] = node->cell;
+    gmk_search_make(&m->pos, node->cell / GOMOKU_SIZE, node->cell % GOMOKU_SIZE, p, &m->undo[ply]);
+    ply++;
+    path[++depth] = node;
+    p = (uint8_t)(3 - p);
+  }
+  if (!done) winner = rollout(m, p, &ply);
+  /* 回传：path[k] 是第 k 手，根走的是 AI，奇数手为 AI */
+  path[0]->visits++;
+  for (int k = 1; k <= depth; k++) {
+    uint8_t mover = (k & 1) ? AI_PLAYER : HU_PLAYER;
+    path[k]->visits++;
+    path[k]->wins2 += winner == 0 ? 1u : winner == mover ? 2u : 0u;
+  }
+  while (ply > 0) {
+    ply--;
+    gmk_search_unmake(&m->pos, m->moves[ply] / GOMOKU_SIZE, m->moves[ply] % GOMOKU_SIZE, &m->undo[ply]);
+  }
+  m->playouts++;
+}
+
+uint32_t gmk_mcts_run(GmkMcts *m, uint32_t playouts, uint64_t deadline_us) {
+  uint32_t done = 0;
+  while (done < playouts) {
+    if (deadline_us && (done % MCTS_CLOCK_CHECK) == 0 && done > 0 && game_clock_us() >= deadline_us) break;
+    playout(m);
+    done++;
+  }
+  return done;
+}
+
+void gmk_mcts_root_visits(const GmkMcts *m, uint32_t visits[GOMOKU_SIZE * GOMOKU_SIZE]) {
+  const GmkMctsNode *root = &m->nodes[0];
+  for (int i = 0; i < root->n_children; i++) {
+    const GmkMctsNode *ch = &m->nodes[root->first_child + i];
+    visits[ch->cell] += ch->visits;
+  }
+}
+
+int gmk_mcts_best(const GmkMcts *m) {
+  const GmkMctsNode *root = &m->nodes[0];
+  int best = -1;
+  uint32_t best_visits = 0;
+  for (int i = 0; i < root->n_children; i++) {
+    const GmkMctsNode *ch = &m->nodes[root->first_child + i];
+    if (best < 0 || ch->visits > best_visits) {
+      best = ch->cell;
+      best_visits = ch->visits;
+    }
+  }
+  return best;
+}
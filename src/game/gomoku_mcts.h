@@ -0,0 +1,52 @@
+/**
+ * @file gomoku_mcts.h
+ * @brief 五子棋 UCT 蒙特卡洛树搜索：节点取自固定大小的池，模拟走子带威胁判断，按模拟次数与时间限额
+ *
+ * 根局面总是 AI（2）走。每个上下文各自独立，主机上可多线程各跑一个（根并行），
+ * 再用 gmk_mcts_root_visits 合并根着法的访问次数。
+ */
+#ifndef PICO_CODE_GOMOKU_MCTS_H
+#define PICO_CODE_GOMOKU_MCTS_H
+
+#include <stdint.h>
+#include "game/gomoku_search.h"
+
+/* 节点池：每个 12 字节；Pico 上 1024 个约 12KB，主机上可用 -DGMK_MCTS_NODES=65536 加大 */
+#ifndef GMK_MCTS_NODES
+#define GMK_MCTS_NODES 1024
+#endif
+/* 每个节点只展开局部棋型分最高的这么多个候选 */
+#ifndef GMK_MCTS_WIDTH
+#define GMK_MCTS_WIDTH 12
+#endif
+/* 树内路径与单次模拟的最大手数；模拟到头仍未分胜负时按评估定胜负 */
+#define GMK_MCTS_MAX_DEPTH      40
+#define GMK_MCTS_ROLLOUT_PLIES  24
+
+typedef struct {
+  uint32_t visits;
+  uint32_t wins2;        /* 从走这步的一方看：胜记 2、和记 1 */
+  uint16_t first_child;  /* 子节点在池中连续存放；0 = 未展开（0 号是根，不会是子节点） */
+  uint8_t n_children;
+  uint8_t cell;          /* r*15+c */
+} GmkMctsNode;
+
+typedef struct {
+  GmkSearch pos;         /* 根局面；每次模拟走的子都原样退回 */
+  GmkMctsNode nodes[GMK_MCTS_NODES];
+  uint32_t used;
+  uint32_t rng;
+  uint32_t playouts;
+  GmkUndo undo[GMK_MCTS_MAX_DEPTH + GMK_MCTS_ROLLOUT_PLIES];
+  uint8_t moves[GMK_MCTS_MAX_DEPTH + GMK_MCTS_ROLLOUT_PLIES];
+} GmkMcts;
+
+void gmk_mcts_init(GmkMcts *m, const uint8_t board[GOMOKU_SIZE][GOMOKU_SIZE], uint32_t seed);
+/* 最多再做 playouts 次模拟，deadline_us 非 0 时到点即停；返回实际做的次数 */
+uint32_t gmk_mcts_run(GmkMcts *m, uint32_t playouts, uint64_t deadline_us);
+/* 把根着法的访问次数累加到 visits[r*15+c] */
+void gmk_mcts_root_visits(const GmkMcts *m, uint32_t visits[GOMOKU_SIZE * GOMOKU_SIZE]);
+/* 访问次数最多的根着法（r*15+c）；根未展开时返回 -1 */
+int gmk_mcts_best(const GmkMcts *m);
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @file gomoku_par.c
+ */
+
+#include "game/gomoku_par.h"
+
+#if defined(PICO_ON_DEVICE) && defined(LIB_PICO_MULTICORE)
+#include <stdint.h>
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+
+/* core1 的栈：alphabeta 每层约 1KB（候选数组），10 层加 VCF 留足余量；由调用方预留（gmk_par_stack_bytes） */
+#define GMK_CORE1_STACK_BYTES (16 * 1024)
+
+static spin_lock_t *s_lock;
+static uint32_t s_lock_irq;     /* 持锁者关中断前的状态，只在持锁期间读写 */
+static GmkParFn s_core1_fn;
+static void *s_core1_arg;
+
+static void core1_entry(void) {
+  s_core1_fn(s_core1_arg, 1);
+  multicore_fifo_push_blocking(1);
+  for (;;) __wfi();             /* 等 core0 复位 */
+}
+
+size_t gmk_par_stack_bytes(int n) {
+  return n > 1 ? GMK_CORE1_STACK_BYTES : 0;
+}
+
+int gmk_par_run(int n, GmkParFn fn, void *arg, void *stack) {
+  if (!s_lock) s_lock = spin_lock_init((uint)spin_lock_claim_unused(true));
+  if (n < 2 || !stack) {
+    fn(arg, 0);
+    return 1;
+  }
+  s_core1_fn = fn;
+  s_core1_arg = arg;
+  multicore_reset_core1();
+  multicore_launch_core1_with_stack(core1_entry, (uint32_t *)stack, GMK_CORE1_STACK_BYTES);
+  fn(arg, 0);
+  multicore_fifo_pop_blocking();
+  multicore_reset_core1();
+  return 2;
+}
+
+void gmk_par_lock(void) {
+  uint32_t save = spin_lock_blocking(s_lock);
+  s_lock_irq = save;
+}
+
+void gmk_par_unlock(void) {
+  spin_unlock(s_lock, s_lock_irq);
+}
+
+#elif GMK_PTHREADS
+#include <pthread.h>
+
+typedef struct {
+  GmkParFn fn;
+  void *arg;
+  int worker;
+} GmkParStart;
+
+static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void *par_start(void *p) {
+  GmkParStart *st = p;
+  st->fn(st->arg, st->worker);
+  return NULL;
+}
+
+size_t gmk_par_stack_bytes(int n) {
+  (void)n;
+  return 0;
+}
+
+int gmk_par_run(int n, GmkParFn fn, void *arg, void *stack) {
+  pthread_t tid[GMK_MAX_WORKERS];
+  GmkParStart st[GMK_MAX_WORKERS];
+  int started = 1;
+  (void)stack;
+  if (n > GMK_MAX_WORKERS) n = GMK_MAX_WORKERS;
+  for (int w = 1; w < n; w++) {
+    st[w].fn = fn;
+    st[w].arg = arg;
+    st[w].worker = w;
+    if (pthread_create(&tid[w], NULL, par_start, &st[w]) != 0) break;
+    started++;
+  }
+  fn(arg, 0);
+  for (int w = 1; w < started; w++) pthread_join(tid[w], NULL);
+  return started;
+}
+
+void gmk_par_lock(void) {
+  pthread_mutex_lock(&s_mutex);
+}
+
+void gmk_par_unlock(void) {
+  pthread_mutex_unlock(&s_mutex);
+}
+
+#else
+
+size_t gmk_par_stack_bytes(int n) {
+  (void)n;
+  return 0;
+}
+
+int gmk_par_run(int n, GmkParFn fn, void *arg, void *stack) {
+  (void)n;
+  (void)stack;
+  fn(arg, 0);
+  return 1;
+}
+
+void gmk_par_lock(void) {
+}
+
+void gmk_par_unlock(void) {
+}
+
+#endif
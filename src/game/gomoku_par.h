@@ -0,0 +1,30 @@
+/**
+ * @file gomoku_par.h
+ * @brief 五子棋根节点并行用的 worker：Pico 上为 core1，主机上为 pthread（GMK_PTHREADS=1），其余情况只在调用者上跑
+ *
+ * gmk_par_run 让 fn(arg, 0) 在调用者上运行，fn(arg, 1..) 在其余 worker 上运行，全部返回后才返回。
+ * 其余 worker 的栈由调用方预先分配（gmk_par_stack_bytes，Pico 上为 core1 的 16KB，随五子棋的 AI 上下文一起分配），搜索时不再分配。
+ * 实际的 worker 数可能少于请求数（Pico 只有 2 个核），fn 需自己把没人领的活分掉（见 gomoku_game.c 的偷活队列）。
+ * gmk_par_lock / gmk_par_unlock 为 worker 之间的互斥锁（Pico 上为硬件自旋锁），临界区要短。
+ */
+
+#ifndef PICO_CODE_GOMOKU_PAR_H
+#define PICO_CODE_GOMOKU_PAR_H
+
+#include <stddef.h>
+
+#define GMK_MAX_WORKERS 8
+
+typedef void (*GmkParFn)(void *arg, int worker);
+
+/** n 个 worker 时 gmk_par_run 需要的栈字节数（调用者自己的栈除外；主机上线程自带栈，为 0） */
+size_t gmk_par_stack_bytes(int n);
+
+/** 在最多 n 个 worker 上运行 fn；stack 为 gmk_par_stack_bytes(n) 字节的预留栈（为 0 字节时可传 NULL）。
+ *  返回实际启动的 worker 数（至少 1） */
+int gmk_par_run(int n, GmkParFn fn, void *arg, void *stack);
+
+void gmk_par_lock(void);
+void gmk_par_unlock(void);
+
+#endif /* PICO_CODE_GOMOKU_PAR_H */
@@ -0,0 +1,41 @@
+/**
+ * @file gomoku_policy.c
+ */
+
+#include <string.h>
+#include "game/gomoku_policy.h"
+#include "gomoku_policy_net.h"   /* 构建时由 tools/gomoku_policy/policy.py 生成 */
+
+#if GMK_POLICY_NET_FEATURES != GMK_POLICY_FEATURES || GMK_POLICY_NET_HIDDEN != GMK_POLICY_HIDDEN
+#error "gomoku_policy_net.h does not match gomoku_policy.h; re-export the network"
+#endif
+
+/* 特征号：平面 × 81 + 窗口内行 × 9 + 窗口内列；平面 0 走棋方、1 对方、2 盘外 */
+static void acc_add(int16_t *acc, int plane, int wr, int wc) {
+  const int8_t *w = gmk_policy_w1[(plane * GMK_POLICY_WINDOW + wr) * GMK_POLICY_WINDOW + wc];
+  for (int i = 0; i < GMK_POLICY_HIDDEN; i++) acc[i] = (int16_t)(acc[i] + w[i]);
+}
+
+int32_t gmk_policy_logit(const GmkSearch *s, int r, int c, uint8_t player) {
+  int16_t acc[GMK_POLICY_HIDDEN];
+  memcpy(acc, gmk_policy_b1, sizeof(acc));
+  for (int wr = 0; wr < GMK_POLICY_WINDOW; wr++) {
+    int rr = r + wr - GMK_POLICY_RADIUS;
+    if (rr < 0 || rr >= GOMOKU_SIZE) {
+      for (int wc = 0; wc < GMK_POLICY_WINDOW; wc++) acc_add(acc, 2, wr, wc);
+      continue;
+    }
+    const uint8_t *row = s->b[rr];
+    for (int wc = 0; wc < GMK_POLICY_WINDOW; wc++) {
+      int cc = c + wc - GMK_POLICY_RADIUS;
+      if (cc < 0 || cc >= GOMOKU_SIZE) acc_add(acc, 2, wr, wc);
+      else if (row[cc]) acc_add(acc, row[cc] == player ? 0 : 1, wr, wc);
+    }
+  }
+  int32_t sum = 0;
+  for (int i = 0; i < GMK_POLICY_HIDDEN; i++) {
+    int32_t h = acc[i] < 0 ? 0 : acc[i] > GMK_POLICY_QA ? GMK_POLICY_QA : acc[i];
+    sum += h * gmk_policy_w2[i];
+  }
+  return sum;
+}
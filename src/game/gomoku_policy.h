@@ -0,0 +1,30 @@
+/**
+ * @file gomoku_policy.h
+ * @brief 可选的五子棋量化策略网络：给候选格打分，Alpha-Beta 只展开分最高的几个
+ *
+ * 结构为两层卷积，只在候选格上求值（裁剪）：以候选格为中心的 9×9 窗口、3 个输入平面
+ * （走棋方 / 对方 / 盘外）→ 16 个 int16 隐单元（第一层 int8 权重）→ 截断 ReLU → int8 输出权重，得到该格的 logit。
+ * 窗口内只有有子的格和盘外格参与累加，每个候选格约几百次加法。
+ * 以 GOMOKU_POLICY=1 编译时启用（CMake 选项 GOMOKU_POLICY），否则不参与编译。
+ * 权重约 4KB，const 放在 flash，由 tools/gomoku_policy/policy.py 在构建时导出为 gomoku_policy_net.h。
+ */
+
+#ifndef PICO_CODE_GOMOKU_POLICY_H
+#define PICO_CODE_GOMOKU_POLICY_H
+
+#include <stdint.h>
+#include "game/gomoku_search.h"
+
+#define GMK_POLICY_RADIUS   4
+#define GMK_POLICY_WINDOW   (2 * GMK_POLICY_RADIUS + 1)
+#define GMK_POLICY_PLANES   3
+#define GMK_POLICY_FEATURES (GMK_POLICY_PLANES * GMK_POLICY_WINDOW * GMK_POLICY_WINDOW)
+#define GMK_POLICY_HIDDEN   16
+/* 量化：隐单元 127 = 1.0（截断上限），输出权重 64 = 1.0 */
+#define GMK_POLICY_QA       127
+#define GMK_POLICY_QB       64
+
+/** player 在空位 (r,c) 落子的 logit（越大越像好棋；只用于同一局面内排序） */
+int32_t gmk_policy_logit(const GmkSearch *s, int r, int c, uint8_t player);
+
+#endif /* PICO_CODE_GOMOKU_POLICY_H */
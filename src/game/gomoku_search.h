@@ -0,0 +1,88 @@
+/*
+ * 五子棋搜索局面：gomoku_game.c 的 Alpha-Beta 与 gomoku_mcts.c 共用。
+ * 按线存双方位图与棋型分、候选位图、威胁索引与 Zobrist 键，落子/提子时增量维护
+ */
+#ifndef PICO_CODE_GOMOKU_SEARCH_H
+#define PICO_CODE_GOMOKU_SEARCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "game/gomoku_game.h"
+
+#define HU_PLAYER  1
+#define AI_PLAYER  2
+
+/* 棋型权重（与文献一致，单位：分） */
+#define SCORE_FIVE    100000
+#define SCORE_LIVE4   10000
+#define SCORE_BLOCK4  5000
+#define SCORE_LIVE3   2000
+#define SCORE_BLOCK3  500
+#define SCORE_LIVE2   100
+#define SCORE_BLOCK2  30
+
+#define SCORE_WIN   SCORE_FIVE
+#define SCORE_LOSS  (-SCORE_FIVE)
+
+/* 能连成五的线共 72 条：15 行、15 列、两个斜向各 21 条长度 >= 5 的斜线（更短的斜线永远成不了五，不计分） */
+#define DIAG_LINES (2 * GOMOKU_SIZE - 9)
+#define GMK_LINES  (2 * GOMOKU_SIZE + 2 * DIAG_LINES)
+
+/* 威胁索引的两类格：落子即成五 / 落子成四（活四或冲四） */
+#define THREAT_FIVE 0
+#define THREAT_FOUR 1
+
+/* 杀手着法表的层数上限 */
+#define GMK_MAX_PLY 32
+
+typedef struct {
+  uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE];
+  uint32_t line_bits[GMK_LINES][2];   /* [线][player-1]：该方棋子的位图 */
+  int line_score[GMK_LINES][2];   /* [线][player-1]：该线上该方各子组棋型分之和 */
+  int total[2];                   /* 各线之和，即该方全盘棋型分 */
+  /* 邻域计数：near[r][c] = 以 (r,c) 为中心 GMK_CANDIDATE_RADIUS 范围内的子数；
+   * cand_rows[r] 的 bit c = 该格为空且 near > 0，即候选格。随搜索中的落子/提子增量维护 */
+  uint8_t near[GOMOKU_SIZE][GOMOKU_SIZE];
+  uint16_t cand_rows[GOMOKU_SIZE];
+  int stones;
+  /* 威胁索引：line_threat[线][player-1][类] 为该线上 player 落子即成五 / 成四的空格（按线上格号）；
+   * threat_cnt 为每格被几条线标记，threat_rows 为计数 > 0 的格，threat_cells 为这样的格数。
+   * 只随真正的落子/提子（gmk_search_make）更新，每次只重算 4 条线上以该点为中心的 9 格 */
+  uint16_t line_threat[GMK_LINES][2][2];
+  uint8_t threat_cnt[2][2][GOMOKU_SIZE][GOMOKU_SIZE];
+  uint16_t threat_rows[2][2][GOMOKU_SIZE];
+  int threat_cells[2][2];
+  /* Zobrist 键：keys[t] 为盘面经第 t 种对称变换后的键（t = 0 为原盘），随 gmk_search_make 增量更新；
+   * 子数超过 GMK_TT_SYM_STONES 时 keys[1..7] 不维护 */
+  uint64_t keys[8];
+  uint32_t nodes;
+  uint32_t gen_us;                /* collect_candidates 累计耗时 */
+  uint32_t tt_probes, tt_hits, tt_cuts;
+  uint32_t vcf_nodes, vcf_limit;  /* VCF 累计节点；本次求解到 vcf_limit 为止 */
+  uint64_t deadline;              /* 非 0 时 alphabeta 到点即中止（aborted），结果作废 */
+  uint8_t policy_k;               /* 非 0 时内部节点只展开策略网络分最高的这么多个候选（需 GOMOKU_POLICY） */
+  struct GmkAiContext *ai;        /* 置换表与 VCF 备忘所在的 AI 上下文（gomoku_game.c）；gmk_search_init 置 NULL */
+  bool aborted;
+  /* 着法排序：按层的杀手着法（r*15+c，-1 为空）与按格的历史分，每步 search_init 时清空 */
+  int16_t killers[GMK_MAX_PLY][2];
+  uint32_t history[2][GOMOKU_SIZE * GOMOKU_SIZE];
+} GmkSearch;
+
+/* 落子前 4 条线的分（与威胁位），提子时原样恢复，不必再扫 */
+typedef struct {
+  int score[4][2];
+  uint16_t threat[4][2][2];
+} GmkUndo;
+
+void gmk_search_init(GmkSearch *s, const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE]);
+/* 真正走一步/退一步（u 由 gmk_search_make 填写，退时原样传回） */
+void gmk_search_make(GmkSearch *s, int r, int c, uint8_t player, GmkUndo *u);
+void gmk_search_unmake(GmkSearch *s, int r, int c, const GmkUndo *u);
+/* 局面评估：正数对 AI 有利，已有五连时为胜负分 */
+int gmk_search_evaluate(const GmkSearch *s);
+/* player 的某类威胁格（THREAT_FIVE / THREAT_FOUR）中行优先的第一个；没有返回 false */
+bool gmk_search_first_threat(const GmkSearch *s, uint8_t player, int kind, int *out_r, int *out_c);
+/* player 在空位 (r,c) 落子的局部棋型分（己方能成的 + 挡住对方的） */
+int gmk_search_cell_score(const GmkSearch *s, int r, int c, uint8_t player);
+
+#endif
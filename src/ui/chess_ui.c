@@ -10,13 +10,20 @@
 #include "game/chess_state.h"
 #include "game/chess_move.h"
 #include "game/chess_legal.h"
-#include "game/chess_result.h"
-#include "game/chess_check.h"
+#include "game/chess_status.h"
+#include "game/chess_engine.h"
 #include "game/chess_ai.h"
+#include "game/chess_uci.h"
+#include "game/chess_notation.h"
+#include "game/chess_search.h"
+#include "game/chess_record.h"
+#include "game/chess_analysis.h"
 #include "game/chess_pieces_small.h"
+#include "game/game_clock.h"
 #include "DEV_Config.h"
 #include "LCD_1in3.h"
 #include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -39,6 +46,16 @@
 #define C_DARK    0x3186
 #define C_LIGHT   0xC618
 
+/* 1 = AI 走子后在状态栏显示搜索统计（深度/节点/耗时/速度）；串口总是输出完整统计 */
+#ifndef CHESS_UI_SHOW_STATS
+#define CHESS_UI_SHOW_STATS 0
+#endif
+
+/* 终局后按 A 的复盘分析：每个局面的搜索时间（ms），每轮主循环分析一个局面 */
+#ifndef CHESS_UI_ANALYSIS_MS
+#define CHESS_UI_ANALYSIS_MS 300
+#endif
+
 /* 5x7 字形：空格 + Check! YOU WIN LOST DRAW 等 */
 static const uint8_t font_chess[][7] = {
   {0,0,0,0,0,0,0},                     /* space */
@@ -74,6 +91,19 @@ static const uint8_t font_chess[][7] = {
   {0x00,0x00,0x0E,0x11,0x11,0x11,0x11}, /* n：弧顶+右竖，标准 5x7 */
   {0x00,0x0F,0x11,0x11,0x0F,0x01,0x0E}, /* g */
   {0x00,0x00,0x0E,0x10,0x10,0x10,0x0E}, /* c：Check! 用 */
+  {0x0E,0x11,0x13,0x15,0x19,0x11,0x0E}, /* 0：以下数字与 / 供统计读数 */
+  {0x04,0x0C,0x04,0x04,0x04,0x04,0x0E}, /* 1 */
+  {0x0E,0x11,0x01,0x02,0x04,0x08,0x1F}, /* 2 */
+  {0x1F,0x02,0x04,0x02,0x01,0x11,0x0E}, /* 3 */
+  {0x02,0x06,0x0A,0x12,0x1F,0x02,0x02}, /* 4 */
+  {0x1F,0x10,0x1E,0x01,0x01,0x11,0x0E}, /* 5 */
+  {0x06,0x08,0x10,0x1E,0x11,0x11,0x0E}, /* 6 */
+  {0x1F,0x01,0x02,0x04,0x08,0x08,0x08}, /* 7 */
+  {0x0E,0x11,0x11,0x0E,0x11,0x11,0x0E}, /* 8 */
+  {0x0E,0x11,0x11,0x0F,0x01,0x02,0x0C}, /* 9 */
+  {0x00,0x01,0x02,0x04,0x08,0x10,0x00}, /* / */
+  {0x0C,0x04,0x04,0x04,0x04,0x04,0x0E}, /* l：Analysis 用 */
+  {0x0E,0x11,0x01,0x02,0x04,0x00,0x04}, /* ?：分析汇总的 ?! ? ?? */
 };
 
 static int chess_font_idx(char ch) {
@@ -110,7 +140,12 @@ static int chess_font_idx(char ch) {
     case 'n': return 30;
     case 'g': return 31;
     case 'c': return 32;
-    default:  return 0;
+    case '/': return 43;
+    case 'l': return 44;
+    case '?': return 45;
+    default:
+      if (ch >= '0' && ch <= '9') return 33 + (ch - '0');
+      return 0;
   }
 }
 
@@ -142,9 +177,9 @@ static void draw_pieces(FrameBuffer *fb, const ChessBoardState *state) {
       if (piece == CHESS_EMPTY) continue;
       int px = BOARD_OFF_X + c * CELL_SIZE + (CELL_SIZE - PIECE_SIZE) / 2;
       int py = BOARD_OFF_Y + r * CELL_SIZE + (CELL_SIZE - PIECE_SIZE) / 2;
-      uint16_t fg = (piece >= 6) ? C_WHITE : C_BLACK;
+      uint16_t fg = (chess_piece_color(piece) == CHESS_COLOR_WHITE) ? C_WHITE : C_BLACK;
       uint16_t bg = ((r + c) & 1) ? C_LIGHT : C_DARK;
-      const uint8_t *bitmap = chess_pieces_small[(int)piece];
+      const uint8_t *bitmap = chess_pieces_small[chess_piece_sprite(piece)];
       chess_draw_piece_fb(fb, px, py, bitmap, CHESS_PIECE_SMALL_W, CHESS_PIECE_SMALL_H, fg, bg);
     }
   }
@@ -161,12 +196,20 @@ static void draw_cursor(FrameBuffer *fb, int cur_r, int cur_c) {
 
 /* 不再绘制可走位置绿框（需求：选中后不显示绿色提示） */
 
-static void draw_status(FrameBuffer *fb, int game_result, int white_in_check) {
+/* stats 非 NULL 且无其它提示时显示上一步 AI 的搜索读数，如 "D3 N1234 56ms 22k/s" */
+static void draw_status(FrameBuffer *fb, int game_result, int white_in_check, const ChessSearchStats *stats) {
   fb_fill_rect(fb, 0, STATUS_Y, LCD_W, STATUS_H, C_BLACK);
   if (game_result == 1) { chess_draw_text(fb, (LCD_W - 6*9) / 2, STATUS_Y + 4, "YOU WIN!", C_GREEN); return; }
   if (game_result == 2) { chess_draw_text(fb, (LCD_W - 6*10) / 2, STATUS_Y + 4, "YOU LOST!", C_RED); return; }
   if (game_result == 3) { chess_draw_text(fb, (LCD_W - 6*5) / 2, STATUS_Y + 4, "DRAW!", C_GRAY); return; }
   if (white_in_check)   { chess_draw_text(fb, (LCD_W - 6*6) / 2, STATUS_Y + 4, "Check!", C_YELLOW); return; }
+  if (stats) {
+    char line[40];
+    int n = snprintf(line, sizeof(line), "D%d N%lu %lums %luk/s", stats->depth, (unsigned long)stats->nodes,
+                     (unsigned long)(stats->elapsed_us / 1000u), (unsigned long)(stats->nps / 1000u));
+    if (n > (int)sizeof(line) - 1) n = (int)sizeof(line) - 1;
+    chess_draw_text(fb, (LCD_W - 6*n) / 2, STATUS_Y + 4, line, C_GRAY);
+  }
 }
 
 static void draw_status_ai_thinking(FrameBuffer *fb) {
@@ -174,6 +217,24 @@ static void draw_status_ai_thinking(FrameBuffer *fb) {
   chess_draw_text(fb, (LCD_W - 6*14) / 2, STATUS_Y + 4, "AI Thinking...", C_GRAY);
 }
 
+/* 复盘分析：进行中显示 "Analysis 已分析/总局面数"，完成后显示白方（人类）的 ?! ? ?? 个数与总耗时 */
+static void draw_status_analysis(FrameBuffer *fb, const ChessAnalysis *an, const ChessGameRecord *rec, bool running) {
+  char line[40];
+  int n;
+  if (running) {
+    n = snprintf(line, sizeof(line), "Analysis %d/%d", an->count - an->next, an->count + 1);
+  } else {
+    int counts[CHESS_ANALYSIS_GRADES];
+    chess_analysis_count(an, rec, 1, counts);
+    n = snprintf(line, sizeof(line), "?! %d ? %d ?? %d %lus", counts[CHESS_ANALYSIS_INACCURACY],
+                 counts[CHESS_ANALYSIS_MISTAKE], counts[CHESS_ANALYSIS_BLUNDER],
+                 (unsigned long)(an->stats.elapsed_us / 1000000u));
+  }
+  if (n > (int)sizeof(line) - 1) n = (int)sizeof(line) - 1;
+  fb_fill_rect(fb, 0, STATUS_Y, LCD_W, STATUS_H, C_BLACK);
+  chess_draw_text(fb, (LCD_W - 6*n) / 2, STATUS_Y + 4, line, running ? C_GRAY : C_YELLOW);
+}
+
 static void draw_last_ai_highlight(FrameBuffer *fb, int to_r, int to_c) {
   if (to_r < 0 || to_c < 0) return;
   int x = BOARD_OFF_X + to_c * CELL_SIZE, y = BOARD_OFF_Y + to_r * CELL_SIZE;
@@ -195,14 +256,15 @@ static void draw_selected_highlight(FrameBuffer *fb, int sel_r, int sel_c) {
   fb_fill_rect(fb, x + CELL_SIZE - bw, y, bw, CELL_SIZE, C_YELLOW);
 }
 
+#define CHESS_MENU_UCI 2   /* 难度页第三项：USB 串口 UCI 引擎模式 */
+
 static void draw_difficulty_screen(FrameBuffer *fb, int selection) {
   fb_fill_rect(fb, 0, 0, LCD_W, LCD_H, C_BLACK);
   int box_h = 56;
-  int y0 = 60, y1 = 140;
   uint16_t border = C_DARK;
   int bw = 2;
-  for (int i = 0; i < 2; i++) {
-    int y = (i == 0) ? y0 : y1;
+  for (int i = 0; i < 3; i++) {
+    int y = 24 + i * (box_h + 8);
     border = (i == selection) ? C_YELLOW : C_DARK;
     fb_fill_rect(fb, 40, y, LCD_W - 80, box_h, C_BLACK);
     fb_fill_rect(fb, 40, y, LCD_W - 80, bw, border);
@@ -211,13 +273,13 @@ static void draw_difficulty_screen(FrameBuffer *fb, int selection) {
     fb_fill_rect(fb, LCD_W - 40 - bw, y, bw, box_h, border);
     if (i == selection)
       fb_fill_rect(fb, 52, y + box_h/2 - 6, 12, 12, C_YELLOW);
-    const char *label = (i == 0) ? "Easy" : "Medium";
-    int len = (i == 0) ? 4 : 6;
+    const char *label = (i == 0) ? "Easy" : (i == 1) ? "Medium" : "UCI";
+    int len = (int)strlen(label);
     chess_draw_text(fb, (LCD_W - len * 6) / 2, y + box_h/2 - 4, label, C_WHITE);
   }
 }
 
-/* 难度选择：返回 CHESS_AI_EASY 或 CHESS_AI_MEDIUM；选 X 返回 -1 表示退出到菜单 */
+/* 难度选择：返回 CHESS_AI_EASY、CHESS_AI_MEDIUM 或 CHESS_MENU_UCI；选 X 返回 -1 表示退出到菜单 */
 static int run_difficulty_selection(FrameBuffer *fb) {
   int selection = 0;
   draw_difficulty_screen(fb, selection);
@@ -232,24 +294,108 @@ static int run_difficulty_selection(FrameBuffer *fb) {
 
   while (1) {
     if (input_button_pressed(&btn_x, 200)) return -1;
-    if (input_button_pressed(&btn_up, 150))   { selection = 0; draw_difficulty_screen(fb, selection); LCD_1IN3_Display((UWORD *)fb->buf); }
-    if (input_button_pressed(&btn_down, 150)) { selection = 1; draw_difficulty_screen(fb, selection); LCD_1IN3_Display((UWORD *)fb->buf); }
+    if (input_button_pressed(&btn_up, 150))   { if (selection > 0) selection--; draw_difficulty_screen(fb, selection); LCD_1IN3_Display((UWORD *)fb->buf); }
+    if (input_button_pressed(&btn_down, 150)) { if (selection < 2) selection++; draw_difficulty_screen(fb, selection); LCD_1IN3_Display((UWORD *)fb->buf); }
     if (input_button_pressed(&btn_a, 150) || input_button_pressed(&btn_ctrl, 150))
       return selection;
     DEV_Delay_ms(20);
   }
 }
 
-static void full_redraw(FrameBuffer *fb, const ChessBoardState *state,
+/* ---------- UCI 模式：USB CDC stdio 收发，X 键退出 ---------- */
+typedef struct {
+  InputButton *btn_x;
+  char buf[CHESS_UCI_LINE_MAX];
+  int len;
+} UciUsbIo;
+
+static int uci_usb_read_line(char *out, int size, int blocking, void *user) {
+  UciUsbIo *io = (UciUsbIo *)user;
+  while (1) {
+    int ch = getchar_timeout_us(0);
+    if (ch == PICO_ERROR_TIMEOUT) {
+      if (input_button_pressed(io->btn_x, 250)) return -1;
+      if (!blocking) return 0;
+      DEV_Delay_ms(1);
+      continue;
+    }
+    if (ch == '\r') continue;
+    if (ch != '\n') {
+      if (io->len < (int)sizeof(io->buf) - 1) io->buf[io->len++] = (char)ch;
+      continue;
+    }
+    int n = (io->len < size - 1) ? io->len : size - 1;
+    memcpy(out, io->buf, (size_t)n);
+    out[n] = '\0';
+    io->len = 0;
+    return 1;
+  }
+}
+
+static void run_uci_mode(FrameBuffer *fb, ChessEngine *eng) {
+  fb_fill_rect(fb, 0, 0, LCD_W, LCD_H, C_BLACK);
+  chess_draw_text(fb, (LCD_W - 6*8) / 2, LCD_H / 2 - 4, "UCI MODE", C_YELLOW);
+  LCD_1IN3_Display((UWORD *)fb->buf);
+
+  InputButton btn_x;
+  input_button_init(&btn_x, PIN_BTN_X);
+  static UciUsbIo io;
+  static ChessUci uci;
+  io.btn_x = &btn_x;
+  io.len = 0;
+  chess_uci_init(&uci, eng, uci_usb_read_line, &io);
+  chess_uci_loop(&uci);
+}
+
+/* 后台思考每片时长：片间回到主循环轮询按键并刷新 */
+#define CHESS_PONDER_SLICE_MS 15
+
+/* AI 思考每片时长（微秒）：片间照常轮询按键、刷新光标，界面帧间隔约为此值加一次刷屏 */
+#ifndef CHESS_AI_STEP_US
+#define CHESS_AI_STEP_US 10000u
+#endif
+
+static const uint8_t s_chess_pins[] = {
+  PIN_BTN_A, PIN_BTN_B, PIN_BTN_X, PIN_BTN_Y,
+  PIN_JOY_UP, PIN_JOY_DOWN, PIN_JOY_LEFT, PIN_JOY_RIGHT, PIN_JOY_CTRL
+};
+
+/* 后台思考的中断条件：任一键处于按下电平（不消耗 InputButton 的边沿状态） */
+static int chess_any_button_down(void *user) {
+  (void)user;
+  for (unsigned i = 0; i < sizeof(s_chess_pins); i++)
+    if (DEV_Digital_Read(s_chess_pins[i]) == 0) return 1;
+  return 0;
+}
+
+/* 复盘分析的中断条件：B（重开）或 X（退出）处于按下电平；置引擎（user）的 abort 使整个分析结束，按键边沿留给主循环处理 */
+static int chess_analysis_cancel(void *user) {
+  ChessEngine *eng = (ChessEngine *)user;
+  if (DEV_Digital_Read(PIN_BTN_B) != 0 && DEV_Digital_Read(PIN_BTN_X) != 0) return 0;
+  eng->abort = 1;
+  return 1;
+}
+
+/* 每步 AI 走完后经 USB stdio 输出一行搜索统计（含思考期间最长的主循环帧间隔），便于在真机上发现性能退化 */
+static void report_ai_stats(ChessEngine *eng, const ChessMove *ai_move, ChessSearchStats *stats, uint32_t frame_max_us) {
+  char mv[8], line[160];
+  chess_ai_last_stats(eng, stats);
+  chess_move_to_uci(ai_move, mv);
+  chess_search_stats_format(stats, line, sizeof(line));
+  printf("ai %s %s frame-max %luus\n", mv, line, (unsigned long)frame_max_us);
+}
+
+/* 只读回合缓存：光标移动/选子/重绘不再做走法生成或将军检测 */
+static void full_redraw(FrameBuffer *fb, const ChessBoardState *state, const ChessTurnStatus *status,
                        int cur_r, int cur_c, int sel_r, int sel_c,
-                       int last_ai_r, int last_ai_c, int game_result) {
+                       int last_ai_r, int last_ai_c, const ChessSearchStats *stats) {
   draw_board(fb);
   draw_pieces(fb, state);
   draw_last_ai_highlight(fb, last_ai_r, last_ai_c);
   draw_selected_highlight(fb, sel_r, sel_c);
   draw_cursor(fb, cur_r, cur_c);
-  int white_check = (state->side_to_move == 1 && chess_is_king_in_check(state, 1)) ? 1 : 0;
-  draw_status(fb, game_result, white_check);
+  int white_check = (state->side_to_move == 1 && status->in_check) ? 1 : 0;
+  draw_status(fb, status->result, white_check, stats);
 }
 
 void chess_run(void) {
@@ -262,6 +408,15 @@ void chess_run(void) {
 
   int difficulty = run_difficulty_selection(&fb);
   if (difficulty < 0) { free(fb.buf); return; }
+  /* 对弈与 UCI 模式共用的引擎上下文（置换表等约 72KB）：只在进入国际象棋时分配，退出即释放，不常驻静态区 */
+  ChessEngine *eng = (ChessEngine *)malloc(sizeof(ChessEngine));
+  if (!eng) {
+    printf("chess: engine alloc failed (%u bytes)\n", (unsigned)sizeof(ChessEngine));
+    free(fb.buf);
+    return;
+  }
+  chess_engine_init(eng, (uint32_t)game_clock_us());
+  if (difficulty == CHESS_MENU_UCI) { run_uci_mode(&fb, eng); free(eng); free(fb.buf); return; }
 
   ChessAiDifficulty ai_diff = (difficulty == 0) ? CHESS_AI_EASY : CHESS_AI_MEDIUM;
 
@@ -278,30 +433,48 @@ void chess_run(void) {
 
   ChessBoardState state;
   chess_state_init_from_initial(&state);
+  chess_engine_new_game(eng);
+  bool pondering = false;
+  bool thinking = false;        /* AI 分片思考中：每轮主循环做一片 */
+  uint64_t last_frame_us = 0;
+  uint32_t frame_max_us = 0;
+  ChessSearchStats ai_stats;
+  const ChessSearchStats *shown_stats = NULL;  /* 仅 CHESS_UI_SHOW_STATS 时指向 ai_stats */
+  /* 约 2.4KB，放静态区以免压栈 */
+  static ChessTurnStatus status;
+  chess_status_build(&state, &status);
+  /* 本局着法与复盘结果（共约 2KB），同样放静态区 */
+  static ChessGameRecord record;
+  static ChessAnalysis analysis;
+  chess_record_init(&record, &state);
+  bool analyzing = false, analyzed = false;
   int cur_r = 4, cur_c = 4;
   int sel_r = -1, sel_c = -1;
   int last_ai_r = -1, last_ai_c = -1;
-  ChessMoveList legal_list;
-  chess_move_list_clear(&legal_list);
 
-  full_redraw(&fb, &state, cur_r, cur_c, sel_r, sel_c, last_ai_r, last_ai_c, 0);
+  full_redraw(&fb, &state, &status, cur_r, cur_c, sel_r, sel_c, last_ai_r, last_ai_c, shown_stats);
   LCD_1IN3_Display((UWORD *)fb.buf);
 
   while (1) {
-    int game_result = chess_get_game_result(&state);
     bool dirty = false;
 
-    if (input_button_pressed(&btn_x, 250)) { free(fb.buf); return; }
+    if (input_button_pressed(&btn_x, 250)) { free(eng); free(fb.buf); return; }
     if (input_button_pressed(&btn_b, 200)) {
       chess_state_init_from_initial(&state);
+      chess_status_build(&state, &status);
+      chess_engine_new_game(eng);
+      chess_record_init(&record, &state);
+      pondering = false;
+      thinking = false;
+      analyzing = analyzed = false;
+      shown_stats = NULL;
       cur_r = cur_c = 4;
       sel_r = sel_c = -1;
       last_ai_r = last_ai_c = -1;
-      chess_move_list_clear(&legal_list);
       dirty = true;
     }
 
-    if (game_result == 0) {
+    if (status.result == 0) {
       if (input_button_pressed(&btn_up, 120))   { if (cur_r > 0) { cur_r--; dirty = true; } }
       if (input_button_pressed(&btn_down, 120)) { if (cur_r < 7) { cur_r++; dirty = true; } }
       if (input_button_pressed(&btn_left, 120))  { if (cur_c > 0) { cur_c--; dirty = true; } }
@@ -312,56 +485,92 @@ void chess_run(void) {
         else {
           if (sel_r >= 0 && cur_r == sel_r && cur_c == sel_c) {
             sel_r = sel_c = -1;
-            chess_move_list_clear(&legal_list);
             dirty = true;
           } else if (sel_r >= 0) {
-            int found = 0;
-            ChessMove chosen;
-            for (int i = 0; i < legal_list.count; i++)
-              if (legal_list.moves[i].to_r == cur_r && legal_list.moves[i].to_c == cur_c) {
-                chosen = legal_list.moves[i];
-                found = 1;
-                break;
-              }
+            const ChessMove *found = chess_status_find_move(&status, sel_r, sel_c, cur_r, cur_c);
             if (found) {
+              ChessMove chosen = *found;
+              chess_record_push(&record, &chosen);
               chess_do_move(&state, &chosen);
+              chess_status_build(&state, &status);
+              pondering = false;
               sel_r = sel_c = -1;
-              chess_move_list_clear(&legal_list);
-              game_result = chess_get_game_result(&state);
               dirty = true;
-              if (game_result == 0 && state.side_to_move == 0) {
-                /* 先显示 "AI Thinking..." 再计算 */
-                full_redraw(&fb, &state, cur_r, cur_c, sel_r, sel_c, last_ai_r, last_ai_c, 0);
-                draw_status_ai_thinking(&fb);
-                LCD_1IN3_Display((UWORD *)fb.buf);
-                ChessMove ai_move;
-                if (chess_ai_pick_move(&state, ai_diff, &ai_move)) {
-                  chess_do_move(&state, &ai_move);
-                  last_ai_r = ai_move.to_r;
-                  last_ai_c = ai_move.to_c;
-                  game_result = chess_get_game_result(&state);
-                }
-                dirty = true;
+              if (status.result == 0 && state.side_to_move == 0) {
+                /* 只开始任务，计算在主循环里分片进行，思考时仍可移动光标、B 重开、X 退出 */
+                chess_ai_begin(eng, &state, ai_diff);
+                thinking = true;
+                frame_max_us = 0;
+                last_frame_us = game_clock_us();
               }
             }
           } else {
-            if (chess_is_own_piece(state.board[cur_r][cur_c], 1)) {
-              chess_legal_moves_from(&state, cur_r, cur_c, &legal_list);
-              if (legal_list.count > 0) {
-                sel_r = cur_r;
-                sel_c = cur_c;
-                dirty = true;
-              }
+            int n;
+            chess_status_moves_from(&status, cur_r, cur_c, &n);
+            if (n > 0) {
+              sel_r = cur_r;
+              sel_c = cur_c;
+              dirty = true;
             }
           }
         }
       }
+    } else if (!analyzing && !analyzed && input_button_pressed(&btn_a, 200)) {
+      /* 终局后按 A：从最后一个局面倒着分析整局，共用置换表 */
+      chess_analysis_begin(&analysis, &record);
+      eng->abort = 0;
+      analyzing = true;
+      dirty = true;
     }
 
     if (dirty) {
-      full_redraw(&fb, &state, cur_r, cur_c, sel_r, sel_c, last_ai_r, last_ai_c, game_result);
+      full_redraw(&fb, &state, &status, cur_r, cur_c, sel_r, sel_c, last_ai_r, last_ai_c, shown_stats);
+      if (thinking) draw_status_ai_thinking(&fb);
+      if (analyzing || analyzed) draw_status_analysis(&fb, &analysis, &record, analyzing);
       LCD_1IN3_Display((UWORD *)fb.buf);
     }
-    DEV_Delay_ms(20);
+    if (thinking) {
+      /* 帧间隔 = 上一片 + 按键轮询 + 刷屏，取思考期间的最大值随统计一起输出 */
+      uint64_t now = game_clock_us();
+      uint32_t frame_us = (uint32_t)(now - last_frame_us);
+      if (frame_us > frame_max_us) frame_max_us = frame_us;
+      last_frame_us = now;
+      if (chess_ai_step(eng, CHESS_AI_STEP_US)) {
+        thinking = false;
+        ChessMove ai_move;
+        if (chess_ai_result(eng, &ai_move)) {
+          chess_record_push(&record, &ai_move);
+          chess_do_move(&state, &ai_move);
+          report_ai_stats(eng, &ai_move, &ai_stats, frame_max_us);
+          if (CHESS_UI_SHOW_STATS) shown_stats = &ai_stats;
+          last_ai_r = ai_move.to_r;
+          last_ai_c = ai_move.to_c;
+          chess_status_build(&state, &status);
+          if (status.result == 0) {
+            chess_ai_ponder_start(eng, &state, ai_diff);
+            pondering = true;
+          }
+        }
+        full_redraw(&fb, &state, &status, cur_r, cur_c, sel_r, sel_c, last_ai_r, last_ai_c, shown_stats);
+        LCD_1IN3_Display((UWORD *)fb.buf);
+      }
+    } else if (analyzing) {
+      ChessSearchLimits limits;
+      chess_search_limits_init(&limits);
+      limits.movetime_ms = CHESS_UI_ANALYSIS_MS;
+      limits.poll = chess_analysis_cancel;
+      limits.poll_user = eng;
+      if (chess_analysis_step(eng, &analysis, &record, &limits)) {
+        analyzing = false;
+        analyzed = true;
+        chess_analysis_print(&analysis, &record);
+      }
+      draw_status_analysis(&fb, &analysis, &record, analyzing);
+      LCD_1IN3_Display((UWORD *)fb.buf);
+    } else if (pondering && !dirty)
+      /* 人类回合的空闲时间用来后台思考，代替空等；有键按下时约 1ms 内返回 */
+      pondering = !chess_ai_ponder_slice(eng, CHESS_PONDER_SLICE_MS, chess_any_button_down, NULL);
+    else
+      DEV_Delay_ms(20);
   }
 }
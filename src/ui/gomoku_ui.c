@@ -6,7 +6,9 @@
 #include "LCD_1in3.h"
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define LCD_W 240
 #define LCD_H 240
@@ -102,6 +104,13 @@ static const uint8_t font5x7_gmk[][7] = {
   {0x10,0x10,0x10,0x10,0x10,0x10,0x1F}, /* L */
   {0x0E,0x11,0x10,0x0E,0x01,0x11,0x0E}, /* S */
   {0x04,0x04,0x04,0x04,0x00,0x04,0x04}, /* ! */
+  {0x1F,0x10,0x10,0x1E,0x10,0x10,0x1F}, /* E */
+  {0x1E,0x11,0x11,0x1E,0x14,0x12,0x11}, /* R */
+  {0x11,0x1B,0x15,0x15,0x11,0x11,0x11}, /* M */
+  {0x1E,0x11,0x11,0x11,0x11,0x11,0x1E}, /* D */
+  {0x11,0x11,0x0A,0x04,0x0A,0x11,0x11}, /* X */
+  {0x1E,0x11,0x11,0x1E,0x10,0x10,0x10}, /* P */
+  {0x0E,0x11,0x10,0x10,0x10,0x11,0x0E}, /* C */
 };
 static int gmk_font_idx(char ch) {
   switch (ch) {
@@ -121,6 +130,13 @@ static int gmk_font_idx(char ch) {
     case 'L': return 13;
     case 'S': return 14;
     case '!': return 15;
+    case 'E': return 16;
+    case 'R': return 17;
+    case 'M': return 18;
+    case 'D': return 19;
+    case 'X': return 20;
+    case 'P': return 21;
+    case 'C': return 22;
     default: return 0;
   }
 }
@@ -150,8 +166,96 @@ static void gmk_draw_game_over_message(FrameBuffer *fb, bool human_won) {
   gmk_draw_text5x7(fb, x, STATUS_Y + 4, msg, color);
 }
 
+/* ---------- 难度选择：EASY / NORMAL 固定层数，HARD / EXPERT 按时间迭代加深，MCTS 为蒙特卡洛树搜索 ---------- */
+static const char *const s_level_label[GMK_LEVEL_COUNT] = { "EASY", "NORMAL", "HARD", "EXPERT", "MCTS" };
+
+static void gmk_draw_level_screen(FrameBuffer *fb, int selection) {
+  fb_fill_rect(fb, 0, 0, LCD_W, LCD_H, C_BLACK);
+  int box_h = 36, bw = 2;
+  for (int i = 0; i < GMK_LEVEL_COUNT; i++) {
+    int y = 14 + i * (box_h + 8);
+    uint16_t border = (i == selection) ? C_YELLOW : C_DARK_GRAY;
+    fb_fill_rect(fb, 40, y, LCD_W - 80, bw, border);
+    fb_fill_rect(fb, 40, y + box_h - bw, LCD_W - 80, bw, border);
+    fb_fill_rect(fb, 40, y, bw, box_h, border);
+    fb_fill_rect(fb, LCD_W - 40 - bw, y, bw, box_h, border);
+    if (i == selection)
+      fb_fill_rect(fb, 52, y + box_h/2 - 6, 12, 12, C_YELLOW);
+    int len = (int)strlen(s_level_label[i]);
+    gmk_draw_text5x7(fb, (LCD_W - len * 6) / 2, y + box_h/2 - 4, s_level_label[i], C_WHITE);
+  }
+}
+
+/* 返回所选 GmkLevel；X 返回 -1 表示退出到菜单 */
+static int gmk_run_level_selection(FrameBuffer *fb) {
+  int selection = GMK_LEVEL_NORMAL;
+  gmk_draw_level_screen(fb, selection);
+  LCD_1IN3_Display((UWORD *)fb->buf);
+
+  InputButton btn_up, btn_down, btn_a, btn_x, btn_ctrl;
+  input_button_init(&btn_up, PIN_JOY_UP);
+  input_button_init(&btn_down, PIN_JOY_DOWN);
+  input_button_init(&btn_a, PIN_BTN_A);
+  input_button_init(&btn_x, PIN_BTN_X);
+  input_button_init(&btn_ctrl, PIN_JOY_CTRL);
+
+  while (1) {
+    if (input_button_pressed(&btn_x, 200)) return -1;
+    if (input_button_pressed(&btn_up, 150) && selection > 0) {
+      selection--;
+      gmk_draw_level_screen(fb, selection);
+      LCD_1IN3_Display((UWORD *)fb->buf);
+    }
+    if (input_button_pressed(&btn_down, 150) && selection < GMK_LEVEL_COUNT - 1) {
+      selection++;
+      gmk_draw_level_screen(fb, selection);
+      LCD_1IN3_Display((UWORD *)fb->buf);
+    }
+    if (input_button_pressed(&btn_a, 150) || input_button_pressed(&btn_ctrl, 150))
+      return selection;
+    DEV_Delay_ms(20);
+  }
+}
+
+/* 每步 AI 走完后经 USB stdio 输出一行搜索统计；MCTS 档没用上 MCTS（退回 Alpha-Beta）时标出 fallback，
+ * workers 为根节点并行实际用到的 worker 数（Pico 上 1 表示 core1 没有参与） */
+static void gmk_report_ai_stats(const GmkGameState *g, int r, int c) {
+  const GmkSearchStats *st = &g->last_stats;
+  bool fallback = g->ai_engine == GMK_ENGINE_MCTS && st->engine != GMK_ENGINE_MCTS;
+  printf("gomoku ai %c%d engine %s%s depth %u workers %u nodes %lu playouts %lu vcf %lu time %luus\n",
+         'a' + c, GOMOKU_SIZE - r, st->engine == GMK_ENGINE_MCTS ? "mcts" : "alphabeta",
+         fallback ? " (mcts fallback)" : "", (unsigned)st->depth, (unsigned)st->workers, (unsigned long)st->nodes,
+         (unsigned long)st->playouts, (unsigned long)st->vcf_nodes, (unsigned long)st->elapsed_us);
+}
+
 void gomoku_run(void) {
   LCD_1IN3_Clear(C_BLACK);
+  FrameBuffer fb;
+  fb.w = LCD_W;
+  fb.h = LCD_H;
+  fb.buf = (uint16_t *)malloc((size_t)fb.w * (size_t)fb.h * sizeof(uint16_t));
+  if (!fb.buf) return;
+  int level = gmk_run_level_selection(&fb);
+  if (level < 0) { free(fb.buf); return; }
+  /* AI 上下文（置换表等，MCTS 档另加节点池）只在进入五子棋时分配，退出即释放，不常驻静态区 */
+  bool mcts = level == GMK_LEVEL_MCTS;
+  int workers = GMK_WORKERS;
+  GmkAiContext *ai = gmk_ai_context_new(mcts, workers);
+  if (!ai && workers > 1) {
+    /* 第二个 worker（core1 栈等）只是加速：放不下就单核对弈，不必退出 */
+    printf("gomoku: ai context alloc failed (%u bytes), running single-core\n",
+           (unsigned)gmk_ai_context_size(mcts, workers));
+    workers = 1;
+    ai = gmk_ai_context_new(mcts, workers);
+  }
+  if (!ai) {
+    printf("gomoku: ai context alloc failed (%u bytes)\n", (unsigned)gmk_ai_context_size(mcts, workers));
+    free(fb.buf);
+    return;
+  }
+  printf("gomoku: ai context %u bytes, %d workers\n", (unsigned)gmk_ai_context_size(mcts, workers), workers);
+
+  /* 选档界面返回后再初始化，按键以当前电平为基准：确认选档时还按着的键不会被当成落子 */
   InputButton btn_a, btn_b, btn_x, btn_y, btn_up, btn_down, btn_left, btn_right, btn_ctrl;
   input_button_init(&btn_a, PIN_BTN_A);
   input_button_init(&btn_b, PIN_BTN_B);
@@ -162,13 +266,10 @@ void gomoku_run(void) {
   input_button_init(&btn_left, PIN_JOY_LEFT);
   input_button_init(&btn_right, PIN_JOY_RIGHT);
   input_button_init(&btn_ctrl, PIN_JOY_CTRL);
-  FrameBuffer fb;
-  fb.w = LCD_W;
-  fb.h = LCD_H;
-  fb.buf = (uint16_t *)malloc((size_t)fb.w * (size_t)fb.h * sizeof(uint16_t));
-  if (!fb.buf) return;
+
   GmkGameState game;
-  gmk_game_init(&game);
+  gmk_game_init(&game, ai);
+  gmk_game_set_level(&game, (GmkLevel)level);
   int cursor_r = GOMOKU_SIZE / 2, cursor_c = GOMOKU_SIZE / 2;
   gmk_render(&game, cursor_r, cursor_c, &fb);
   gmk_draw_status_bar(&fb, false);
@@ -176,6 +277,7 @@ void gomoku_run(void) {
   while (1) {
     bool dirty = false;
     if (input_button_pressed(&btn_x, 250)) {
+      gmk_ai_context_free(ai);
       free(fb.buf);
       return;
     }
@@ -193,7 +295,7 @@ void gomoku_run(void) {
           gmk_draw_status_bar(&fb, true);
           LCD_1IN3_Display((UWORD *)fb.buf);
           int ai_r = 0, ai_c = 0;
-          gmk_game_ai_move(&game, &ai_r, &ai_c);
+          if (gmk_game_ai_move(&game, &ai_r, &ai_c)) gmk_report_ai_stats(&game, ai_r, ai_c);
           for (int i = 0; i < 5; i++) {
             gmk_render_ex(&game, cursor_r, cursor_c, -1, -1, &fb);
             gmk_draw_status_bar(&fb, false);
@@ -213,7 +315,8 @@ void gomoku_run(void) {
       }
     }
     if (input_button_pressed(&btn_b, 200)) {
-      gmk_game_init(&game);
+      gmk_game_init(&game, ai);
+      gmk_game_set_level(&game, (GmkLevel)level);
       cursor_r = cursor_c = GOMOKU_SIZE / 2;
       dirty = true;
     }
@@ -0,0 +1,274 @@
+#!/usr/bin/env python3
+"""
+国际象棋小网络评估（src/game/chess_nnue.h）的训练与导出，纯 Python，无第三方依赖。
+用法：
+  python tools/chess_nnue/nnue.py export -o chess_nnue_net.h              # 与子力评估等价的网络
+  python tools/chess_nnue/nnue.py export --net net.json -o chess_nnue_net.h
+  python tools/chess_nnue/nnue.py train data.txt -o net.json [--init net.json] [--epochs 4]
+
+训练数据每行 "FEN | 分数"，分数为行棋方视角的厘兵（主机工具 "chess_nnue data" 用搜索生成）。
+网络结构、量化与 C 端完全一致：768 输入 → 每方视角 32 个隐单元（截断到 0..127）→ 64 个 int8 输出权重；
+训练直接在量化刻度上用浮点进行，导出时四舍五入即可，默认从子力等价网络开始微调。
+构建时 CMake（-DCHESS_NNUE=ON，可选 -DCHESS_NNUE_NET=net.json）调用 export 生成头文件。
+"""
+
+import argparse
+import json
+import math
+import random
+import sys
+
+FEATURES = 768
+HIDDEN = 32
+QA = 127          # 隐单元截断上限（= 1.0）
+QB = 64           # 输出权重刻度（= 1.0）
+SCALE = 256       # 输出 1.0 对应的厘兵
+OUT_K = SCALE / (QA * QB)
+SIGMOID_CP = 400  # 损失在胜率空间计算：sigmoid(cp / 400)
+
+PIECE_TYPES = {"p": 1, "n": 2, "b": 3, "r": 4, "q": 5, "k": 6}
+MATERIAL = {1: 100, 2: 300, 3: 300, 4: 500, 5: 900, 6: 0}
+
+
+def feature_index(persp: int, color: int, ptype: int, r: int, c: int) -> int:
+    """与 chess_nnue.c 的 feature_index 一致：r=0 为第 8 横线，黑方视角上下翻转。"""
+    enemy = 1 if color != persp else 0
+    row = r if persp == 1 else 7 - r
+    return (enemy * 6 + ptype - 1) * 64 + row * 8 + c
+
+
+def fen_features(fen: str):
+    """返回 (行棋方, [黑方视角特征, 白方视角特征])。"""
+    fields = fen.split()
+    feats = ([], [])
+    for r, rank in enumerate(fields[0].split("/")):
+        c = 0
+        for ch in rank:
+            if ch.isdigit():
+                c += int(ch)
+                continue
+            color = 1 if ch.isupper() else 0
+            ptype = PIECE_TYPES[ch.lower()]
+            for p in (0, 1):
+                feats[p].append(feature_index(p, color, ptype, r, c))
+            c += 1
+    stm = 1 if len(fields) < 2 or fields[1] == "w" else 0
+    return stm, feats
+
+
+def material_net() -> dict:
+    """子力等价网络：隐单元 k（0..15）为己方子力的第 k 段、16..31 为对方的，每段 127 = 508 厘兵。"""
+    w1 = [[0.0] * HIDDEN for _ in range(FEATURES)]
+    for enemy in (0, 1):
+        for ptype in range(1, 7):
+            v = MATERIAL[ptype] / 4
+            for sq in range(64):
+                row = w1[(enemy * 6 + ptype - 1) * 64 + sq]
+                for k in range(16):
+                    row[enemy * 16 + k] = v
+    b1 = [-float(QA * (i % 16)) for i in range(HIDDEN)]
+    w2 = [float(QA) if i < 16 else -float(QA) for i in range(HIDDEN)] + [0.0] * HIDDEN
+    return {"w1": w1, "b1": b1, "w2": w2, "b2": 0.0}
+
+
+def load_net(path):
+    if not path:
+        return material_net()
+    with open(path) as f:
+        net = json.load(f)
+    if len(net["w1"]) != FEATURES or len(net["b1"]) != HIDDEN or len(net["w2"]) != 2 * HIDDEN:
+        sys.exit(f"{path}: network shape does not match {FEATURES}x{HIDDEN}")
+    return net
+
+
+def forward(net, stm, feats):
+    """返回 (厘兵, 两视角累加器)；与 C 端相同的公式，只是不取整。"""
+    accs = []
+    for p in (0, 1):
+        acc = list(net["b1"])
+        for f in feats[p]:
+            row = net["w1"][f]
+            for i in range(HIDDEN):
+                acc[i] += row[i]
+        accs.append(acc)
+    own, opp = accs[stm], accs[1 - stm]
+    w2 = net["w2"]
+    s = net["b2"]
+    for i in range(HIDDEN):
+        s += min(max(own[i], 0.0), QA) * w2[i] + min(max(opp[i], 0.0), QA) * w2[HIDDEN + i]
+    return s * OUT_K, accs
+
+
+def sigmoid(x: float) -> float:
+    return 1.0 / (1.0 + math.exp(-x))
+
+
+def load_data(path: str, clip_cp: int):
+    samples = []
+    with open(path) as f:
+        for line in f:
+            if "|" not in line or line.startswith("#"):
+                continue
+            fen, score = line.rsplit("|", 1)
+            stm, feats = fen_features(fen.strip())
+            cp = max(-clip_cp, min(clip_cp, int(score)))
+            samples.append((stm, feats, cp))
+    return samples
+
+
+class Adam:
+    """逐参数 Adam；第一层只更新本批出现过的特征行（稀疏）。"""
+
+    def __init__(self, lr: float):
+        self.lr, self.b1, self.b2, self.eps = lr, 0.9, 0.999, 1e-8
+        self.m, self.v, self.t = {}, {}, 0
+
+    def step(self, key, params, grads):
+        m = self.m.setdefault(key, [0.0] * len(params))
+        v = self.v.setdefault(key, [0.0] * len(params))
+        c1 = 1 - self.b1 ** self.t
+        c2 = 1 - self.b2 ** self.t
+        for i, g in enumerate(grads):
+            m[i] = self.b1 * m[i] + (1 - self.b1) * g
+            v[i] = self.b2 * v[i] + (1 - self.b2) * g * g
+            params[i] -= self.lr * (m[i] / c1) / (math.sqrt(v[i] / c2) + self.eps)
+
+
+def evaluate_loss(net, samples):
+    loss = err = 0.0
+    for stm, feats, cp in samples:
+        out, _ = forward(net, stm, feats)
+        loss += (sigmoid(out / SIGMOID_CP) - sigmoid(cp / SIGMOID_CP)) ** 2
+        err += abs(out - cp)
+    n = max(1, len(samples))
+    return loss / n, err / n
+
+
+def train(net, samples, epochs: int, batch: int, lr: float, val_frac: float, seed: int):
+    rng = random.Random(seed)
+    rng.shuffle(samples)
+    n_val = int(len(samples) * val_frac)
+    val, data = samples[:n_val], samples[n_val:]
+    opt = Adam(lr)
+    print(f"samples {len(data)} validation {len(val)}")
+    if val:
+        loss, err = evaluate_loss(net, val)
+        print(f"epoch 0 val-loss {loss:.6f} val-mae {err:.1f}cp")
+    for epoch in range(1, epochs + 1):
+        rng.shuffle(data)
+        for start in range(0, len(data), batch):
+            gw1 = {}
+            gb1 = [0.0] * HIDDEN
+            gw2 = [0.0] * (2 * HIDDEN)
+            gb2 = 0.0
+            chunk = data[start:start + batch]
+            for stm, feats, cp in chunk:
+                out, accs = forward(net, stm, feats)
+                p = sigmoid(out / SIGMOID_CP)
+                d = 2.0 * (p - sigmoid(cp / SIGMOID_CP)) * p * (1.0 - p) / SIGMOID_CP * OUT_K / len(chunk)
+                gb2 += d
+                for half, persp in ((0, stm), (1, 1 - stm)):
+                    acc = accs[persp]
+                    g_acc = [0.0] * HIDDEN
+                    for i in range(HIDDEN):
+                        a = acc[i]
+                        if a <= 0.0:
+                            continue
+                        w = net["w2"][half * HIDDEN + i]
+                        gw2[half * HIDDEN + i] += d * min(a, QA)
+                        if a < QA:
+                            g_acc[i] = d * w
+                    for i in range(HIDDEN):
+                        gb1[i] += g_acc[i]
+                    for f in feats[persp]:
+                        row = gw1.setdefault(f, [0.0] * HIDDEN)
+                        for i in range(HIDDEN):
+                            row[i] += g_acc[i]
+            opt.t += 1
+            for f, g in gw1.items():
+                opt.step(("w1", f), net["w1"][f], g)
+            opt.step("b1", net["b1"], gb1)
+            opt.step("w2", net["w2"], gw2)
+            b2 = [net["b2"]]
+            opt.step("b2", b2, [gb2])
+            net["b2"] = b2[0]
+            # 导出为 int8：训练中就保持在可表示范围内
+            net["w2"] = [min(max(w, -127.0), 127.0) for w in net["w2"]]
+        if val:
+            loss, err = evaluate_loss(net, val)
+            print(f"epoch {epoch} val-loss {loss:.6f} val-mae {err:.1f}cp")
+        else:
+            print(f"epoch {epoch}")
+    return net
+
+
+def quantize(x: float, lo: int, hi: int) -> int:
+    return max(lo, min(hi, int(round(x))))
+
+
+def export_header(net, source: str, path: str) -> None:
+    def row(values):
+        return "{" + ",".join(str(v) for v in values) + "}"
+
+    w1 = [[quantize(x, -32767, 32767) for x in r] for r in net["w1"]]
+    b1 = [quantize(x, -32767, 32767) for x in net["b1"]]
+    w2 = [quantize(x, -127, 127) for x in net["w2"]]
+    b2 = quantize(net["b2"], -(1 << 22), 1 << 22)   # C 端 (sum + b2) * SCALE 不溢出 int32
+    lines = [
+        f"/* 由 tools/chess_nnue/nnue.py 生成，勿手改（网络：{source}） */",
+        "#ifndef PICO_CODE_CHESS_NNUE_NET_H",
+        "#define PICO_CODE_CHESS_NNUE_NET_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        f"#define CHESS_NNUE_NET_FEATURES {FEATURES}",
+        f"#define CHESS_NNUE_NET_HIDDEN {HIDDEN}",
+        "",
+        f"static const int16_t chess_nnue_w1[{FEATURES}][{HIDDEN}] = {{",
+    ]
+    lines += [row(r) + "," for r in w1]
+    lines += [
+        "};",
+        f"static const int16_t chess_nnue_b1[{HIDDEN}] = {row(b1)};",
+        f"static const int8_t chess_nnue_w2[{2 * HIDDEN}] = {row(w2)};",
+        f"static const int32_t chess_nnue_b2 = {b2};",
+        "",
+        "#endif /* PICO_CODE_CHESS_NNUE_NET_H */",
+        "",
+    ]
+    with open(path, "w") as f:
+        f.write("\n".join(lines))
+
+
+def main() -> None:
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = ap.add_subparsers(dest="cmd", required=True)
+    ex = sub.add_parser("export", help="write chess_nnue_net.h")
+    ex.add_argument("--net", help="trained network (JSON); default: material-equivalent net")
+    ex.add_argument("-o", "--output", required=True)
+    tr = sub.add_parser("train", help="train on 'FEN | cp' lines")
+    tr.add_argument("data")
+    tr.add_argument("-o", "--output", required=True)
+    tr.add_argument("--init", help="start from this network (default: material-equivalent net)")
+    tr.add_argument("--epochs", type=int, default=4)
+    tr.add_argument("--batch", type=int, default=256)
+    tr.add_argument("--lr", type=float, default=0.5)
+    tr.add_argument("--val", type=float, default=0.1, help="fraction held out for validation")
+    tr.add_argument("--clip", type=int, default=2000, help="clip target scores to +-N cp")
+    tr.add_argument("--seed", type=int, default=1)
+    args = ap.parse_args()
+
+    if args.cmd == "export":
+        export_header(load_net(args.net), args.net or "material", args.output)
+        return
+    net = load_net(args.init)
+    samples = load_data(args.data, args.clip)
+    if not samples:
+        sys.exit(f"{args.data}: no 'FEN | cp' lines")
+    net = train(net, samples, args.epochs, args.batch, args.lr, args.val, args.seed)
+    with open(args.output, "w") as f:
+        json.dump(net, f)
+
+
+if __name__ == "__main__":
+    main()
@@ -5,13 +5,13 @@
   python tools/chess_piece_scale/scale_pieces.py
   python scale_pieces.py  # 若在 tools/chess_piece_scale 下，需指定 demo 路径
 
-输出：src/game/chess_pieces_small.h（12 枚 28x28，索引 0..11 与 chess_types 一致）
+输出：src/game/chess_pieces_small.h（12 枚 28x28，精灵索引 0..11，由 chess_types 的 CHESS_PIECE_SPRITE 映射）
 """
 
 import re
 import os
 
-# 棋子顺序与 chess_types/CHESS_INITIAL_BOARD 一致：黑象王马兵后车，白象王马兵后车
+# 精灵顺序（CHESS_PIECE_SPRITE 的取值）：黑象王马兵后车，白象王马兵后车
 PIECE_NAMES = [
     "black_bishop", "black_king", "black_knight", "black_pawn", "black_queen", "black_rook",
     "white_bishop", "white_king", "white_knight", "white_pawn", "white_queen", "white_rook",
@@ -120,7 +120,7 @@ def main():
         lines.append("};")
         lines.append("")
 
-    lines.append("/* 索引 0..11 与 chess_types 棋子索引一致 */")
+    lines.append("/* 精灵索引 0..11：黑象王马兵后车、白象王马兵后车；棋子编码经 CHESS_PIECE_SPRITE 换算 */")
     lines.append("static const uint8_t* const chess_pieces_small[12] = {")
     for i in range(12):
         lines.append(f"    chess_piece_small_{i},")
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""
+汇总搜索树跟踪记录（引擎以 CHESS_SEARCH_TRACE=1 编译，见 src/game/chess_trace.h）。
+用法：
+  python tools/chess_trace/trace_summary.py trace.bin        # UCI "trace trace.bin" 写出的二进制
+  python tools/chess_trace/trace_summary.py usb_log.txt      # 串口日志中的 "trace <hex>" 行
+  python tools/chess_trace/trace_summary.py trace.bin --failures 20
+
+输出每层（ply）的节点数、平均分支因子、剪枝数、首着剪枝率，以及剪枝着法序号分布；
+--failures N 列出剪枝序号最大的 N 个节点（排序失误最严重处）。
+"""
+
+import argparse
+import struct
+import sys
+from collections import defaultdict
+
+RECORD = struct.Struct("<BBBBhhhBB")   # 与 ChessTraceRecord 的 12 字节小端布局一致
+MAGIC = b"CTR1"
+NO_CUTOFF = 0xFF
+NO_MOVE = 0xFF
+
+F_QUIESCE = 0x01
+F_TT = 0x02
+F_LEAF = 0x04
+
+
+def square_name(sq: int) -> str:
+    """格号 r*8+c（r=0 为第 8 横线）转代数记法。"""
+    if sq == NO_MOVE:
+        return "--"
+    return "abcdefgh"[sq % 8] + str(8 - sq // 8)
+
+
+def load_records(path: str) -> list:
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] == MAGIC:
+        (count,) = struct.unpack_from("<I", data, 4)
+        body = data[8:8 + count * RECORD.size]
+        return [RECORD.unpack_from(body, i) for i in range(0, len(body), RECORD.size)]
+    records = []
+    for line in data.decode("ascii", errors="ignore").splitlines():
+        parts = line.split()
+        if len(parts) == 2 and parts[0] == "trace" and len(parts[1]) == RECORD.size * 2:
+            records.append(RECORD.unpack(bytes.fromhex(parts[1])))
+    return records
+
+
+def summarize(records: list, failures: int) -> None:
+    nodes = defaultdict(int)
+    moves = defaultdict(int)
+    expanded = defaultdict(int)
+    cutoffs = defaultdict(int)
+    first = defaultdict(int)
+    qnodes = defaultdict(int)
+    tt = defaultdict(int)
+    order_hist = defaultdict(int)
+    worst = []
+
+    for rec in records:
+        ply, from_sq, to_sq, cutoff, alpha, beta, score, nmoves, flags = rec
+        nodes[ply] += 1
+        if flags & F_QUIESCE:
+            qnodes[ply] += 1
+        if flags & F_TT:
+            tt[ply] += 1
+        if not flags & (F_LEAF | F_TT):
+            moves[ply] += nmoves
+            expanded[ply] += 1
+        if cutoff != NO_CUTOFF:
+            cutoffs[ply] += 1
+            order_hist[min(cutoff, 8)] += 1
+            if cutoff == 0:
+                first[ply] += 1
+            else:
+                worst.append((cutoff, nmoves, ply, from_sq, to_sq, alpha, beta, score))
+
+    print("ply    nodes  qnodes   tt-hit  branch  cutoffs  first%")
+    for ply in sorted(nodes):
+        branch = moves[ply] / expanded[ply] if expanded[ply] else 0.0
+        pct = 100.0 * first[ply] / cutoffs[ply] if cutoffs[ply] else 0.0
+        print(f"{ply:3d} {nodes[ply]:8d} {qnodes[ply]:7d} {tt[ply]:8d} {branch:7.2f} "
+              f"{cutoffs[ply]:8d} {pct:6.1f}")
+
+    total_cut = sum(cutoffs.values())
+    print(f"\n{len(records)} records, {total_cut} cutoffs")
+    if total_cut:
+        print("cutoff move index histogram:")
+        for idx in sorted(order_hist):
+            label = f"{idx}" if idx < 8 else "8+"
+            n = order_hist[idx]
+            print(f"  {label:>3}: {n:8d} {100.0 * n / total_cut:6.1f}%")
+
+    if failures > 0 and worst:
+        worst.sort(reverse=True)
+        print(f"\nworst ordering failures (cutoff index / moves):")
+        for cutoff, nmoves, ply, from_sq, to_sq, alpha, beta, score in worst[:failures]:
+            print(f"  ply {ply:2d}  {cutoff:3d}/{nmoves:<3d} {square_name(from_sq)}{square_name(to_sq)}"
+                  f"  window [{alpha}, {beta}]  score {score}")
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description="Summarize a chess search trace")
+    ap.add_argument("path", help="binary trace file or text log with 'trace <hex>' lines")
+    ap.add_argument("--failures", type=int, default=10, help="list the N worst ordering failures")
+    args = ap.parse_args()
+
+    records = load_records(args.path)
+    if not records:
+        print("no trace records found", file=sys.stderr)
+        return 1
+    summarize(records, args.failures)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
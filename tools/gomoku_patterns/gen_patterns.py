@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""
+生成五子棋棋型查表头文件 gomoku_pattern_table.h，不入库：构建时由 CMake（src/game、tools/host）调用，
+经 -o 写到构建目录的 gomoku/ 下：
+  python tools/gomoku_patterns/gen_patterns.py -o <build>/gomoku/gomoku_pattern_table.h
+
+以某一方视角，把一条线上以某子为中心的 9 格窗口（左右各 4 格）编成三进制下标：
+每格 0 = 空、1 = 己方、2 = 挡（对方子或棋盘外），下标 = sum(格值 * 3^i)，i = 0 为最左格。
+表项低 4 位为中心子所在的棋型，按“再下一子能成什么”递归定义，断开的棋型（XX_X、X_XXX 等）自然包含在内：
+  五连  FIVE    窗口内有含中心的 5 连
+  活四  LIVE4   再下一子成五（且五连含中心）的空位 >= 2 个
+  冲四  BLOCK4  这样的空位恰 1 个
+  活三  LIVE3   某个空位下子后成活四
+  眠三  BLOCK3  某个空位下子后成冲四
+  活二  LIVE2   某个空位下子后成活三
+  眠二  BLOCK2  某个空位下子后成眠三
+bit 4（HEAD）表示中心是所在子组的第一个子：左边 1 格不是己方子，且不是“空一格再接己方子”；
+评估只在组首计分，一组棋子的棋型只计一次。另生成 9 位二进制 -> 三进制的换算表，C 端用两次查表拼出下标。
+"""
+
+import argparse
+from functools import lru_cache
+
+WINDOW = 9
+CENTER = 4
+EMPTY, OWN, BLOCKED = 0, 1, 2
+NONE, BLOCK2, LIVE2, BLOCK3, LIVE3, BLOCK4, LIVE4, FIVE = range(8)
+SHAPE_NAMES = ["NONE", "BLOCK2", "LIVE2", "BLOCK3", "LIVE3", "BLOCK4", "LIVE4", "FIVE"]
+HEAD = 0x10
+
+
+def has_five(cells) -> bool:
+    """含中心格的 5 格全为己方。"""
+    for start in range(CENTER - 4, CENTER + 1):
+        if all(cells[i] == OWN for i in range(start, start + 5)):
+            return True
+    return False
+
+
+@lru_cache(maxsize=None)
+def classify(cells) -> int:
+    if has_five(cells):
+        return FIVE
+    empties = [i for i in range(WINDOW) if cells[i] == EMPTY]
+    five_points = sum(1 for i in empties if has_five(cells[:i] + (OWN,) + cells[i + 1:]))
+    if five_points >= 2:
+        return LIVE4
+    if five_points == 1:
+        return BLOCK4
+    best = NONE
+    for i in empties:
+        after = classify(cells[:i] + (OWN,) + cells[i + 1:])
+        # 下一子后的棋型降两级（活四 -> 活三，冲四 -> 眠三，……）
+        if after >= BLOCK3:
+            best = max(best, after - 2)
+    return best
+
+
+def entry(index: int) -> int:
+    cells = []
+    for _ in range(WINDOW):
+        cells.append(index % 3)
+        index //= 3
+    cells = tuple(cells)
+    if cells[CENTER] != OWN:
+        return 0
+    value = classify(cells)
+    left, left2 = cells[CENTER - 1], cells[CENTER - 2]
+    if left != OWN and not (left == EMPTY and left2 == OWN):
+        value |= HEAD
+    return value
+
+
+def ternary(bits: int) -> int:
+    value, power = 0, 1
+    for i in range(WINDOW):
+        if bits >> i & 1:
+            value += power
+        power *= 3
+    return value
+
+
+def main() -> None:
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("-o", "--output", required=True)
+    args = ap.parse_args()
+
+    size = 3 ** WINDOW
+    table = [entry(i) for i in range(size)]
+    tern = [ternary(b) for b in range(1 << WINDOW)]
+    lines = [
+        "/* 由 tools/gomoku_patterns/gen_patterns.py 生成，勿手改 */",
+        "#ifndef PICO_CODE_GOMOKU_PATTERN_TABLE_H",
+        "#define PICO_CODE_GOMOKU_PATTERN_TABLE_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        f"#define GMK_PATTERN_TABLE_WINDOW {WINDOW}",
+        f"#define GMK_PATTERN_TABLE_SHAPES {len(SHAPE_NAMES)}",
+        "",
+        f"static const uint16_t gmk_pattern_ternary[{1 << WINDOW}] = {{",
+    ]
+    lines += [",".join(str(v) for v in tern[i:i + 32]) + "," for i in range(0, len(tern), 32)]
+    lines += ["};", f"static const uint8_t gmk_pattern_table[{size}] = {{"]
+    lines += [",".join(str(v) for v in table[i:i + 48]) + "," for i in range(0, size, 48)]
+    lines += ["};", "", "#endif /* PICO_CODE_GOMOKU_PATTERN_TABLE_H */", ""]
+    with open(args.output, "w") as f:
+        f.write("\n".join(lines))
+
+
+if __name__ == "__main__":
+    main()
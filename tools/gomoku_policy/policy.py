@@ -0,0 +1,312 @@
+#!/usr/bin/env python3
+"""
+五子棋量化策略网络（src/game/gomoku_policy.h）的训练与导出，纯 Python，无第三方依赖。
+用法：
+  python tools/gomoku_policy/policy.py export -o gomoku_policy_net.h              # 随仓库附带的网络 policy_net.json
+  python tools/gomoku_policy/policy.py export --net net.json -o gomoku_policy_net.h
+  python tools/gomoku_policy/policy.py train data.txt -o net.json [--init net.json] [--epochs 6]
+
+训练数据每行 "225 个字符 | 格号"：'x' 为走棋方、'o' 为对方、'.' 为空，格号 r*15+c 为搜索选中的着法
+（主机工具 "gomoku_policy data" 用 Alpha-Beta 自对弈生成）。
+网络结构、量化与 C 端完全一致：以候选格为中心的 9×9 窗口 × 3 个平面（走棋方 / 对方 / 盘外）→ 16 个隐单元
+（截断到 0..127）→ 16 个 int8 输出权重；对局面内全部候选格（已有子 2 格内的空位）做 softmax，损失为交叉熵。
+训练直接在量化刻度上用浮点进行，导出时四舍五入即可；每个样本每轮随机取 8 种对称之一做数据增强。
+构建时 CMake（-DGOMOKU_POLICY=ON，可选 -DGOMOKU_POLICY_NET=net.json）调用 export 生成头文件。
+"""
+
+import argparse
+import json
+import math
+import os
+import random
+import sys
+
+SIZE = 15
+RADIUS = 4
+WINDOW = 2 * RADIUS + 1
+PLANES = 3
+FEATURES = PLANES * WINDOW * WINDOW
+HIDDEN = 16
+QA = 127          # 隐单元截断上限（= 1.0）
+QB = 64           # 输出权重刻度（= 1.0）
+OUT_K = 4.0 / (QA * QB)   # 整数 logit → softmax 的输入
+CAND_RADIUS = 2   # 与 GMK_CANDIDATE_RADIUS 一致
+DEFAULT_NET = os.path.join(os.path.dirname(os.path.abspath(__file__)), "policy_net.json")
+
+
+def sym_cell(t: int, r: int, c: int):
+    """8 种对称：t&4 转置，t&2 上下翻，t&1 左右翻。"""
+    if t & 4:
+        r, c = c, r
+    if t & 2:
+        r = SIZE - 1 - r
+    if t & 1:
+        c = SIZE - 1 - c
+    return r, c
+
+
+def cell_features(board, r: int, c: int):
+    """与 gomoku_policy.c 一致：窗口内的己方子、对方子与盘外格。"""
+    feats = []
+    for wr in range(WINDOW):
+        rr = r + wr - RADIUS
+        for wc in range(WINDOW):
+            cc = c + wc - RADIUS
+            if rr < 0 or rr >= SIZE or cc < 0 or cc >= SIZE:
+                feats.append((2 * WINDOW + wr) * WINDOW + wc)
+            elif board[rr][cc]:
+                feats.append(((board[rr][cc] - 1) * WINDOW + wr) * WINDOW + wc)
+    return feats
+
+
+def candidates(board):
+    cells = []
+    for r in range(SIZE):
+        for c in range(SIZE):
+            if board[r][c]:
+                continue
+            near = any(board[rr][cc]
+                       for rr in range(max(0, r - CAND_RADIUS), min(SIZE, r + CAND_RADIUS + 1))
+                       for cc in range(max(0, c - CAND_RADIUS), min(SIZE, c + CAND_RADIUS + 1)))
+            if near:
+                cells.append((r, c))
+    return cells
+
+
+def parse_line(line: str):
+    """返回 (board, label)；board[r][c]：0 空、1 走棋方、2 对方。"""
+    text, cell = line.rsplit("|", 1)
+    text = text.strip()
+    if len(text) != SIZE * SIZE:
+        raise ValueError("board must have 225 cells")
+    board = [[{"x": 1, "o": 2}.get(text[r * SIZE + c], 0) for c in range(SIZE)] for r in range(SIZE)]
+    label = int(cell)
+    return board, (label // SIZE, label % SIZE)
+
+
+def make_sample(board, label, t: int):
+    """对称变换 t 之后的 (各候选格特征, 着法下标)；着法不在候选中返回 None。"""
+    tb = [[0] * SIZE for _ in range(SIZE)]
+    for r in range(SIZE):
+        for c in range(SIZE):
+            if board[r][c]:
+                rr, cc = sym_cell(t, r, c)
+                tb[rr][cc] = board[r][c]
+    lr, lc = sym_cell(t, *label)
+    cells = candidates(tb)
+    if (lr, lc) not in cells:
+        return None
+    return [cell_features(tb, r, c) for r, c in cells], cells.index((lr, lc))
+
+
+def random_net(seed: int) -> dict:
+    rng = random.Random(seed)
+    w1 = [[rng.uniform(-8.0, 8.0) for _ in range(HIDDEN)] for _ in range(FEATURES)]
+    b1 = [rng.uniform(0.0, 32.0) for _ in range(HIDDEN)]
+    w2 = [rng.uniform(-16.0, 16.0) for _ in range(HIDDEN)]
+    return {"w1": w1, "b1": b1, "w2": w2}
+
+
+def load_net(path):
+    with open(path) as f:
+        net = json.load(f)
+    if len(net["w1"]) != FEATURES or len(net["b1"]) != HIDDEN or len(net["w2"]) != HIDDEN:
+        sys.exit(f"{path}: network shape does not match {FEATURES}x{HIDDEN}")
+    return net
+
+
+def forward(net, cand_feats):
+    """返回 (各候选格 logit, 各候选格隐单元累加器)；与 C 端相同的公式，只是不取整。"""
+    w1, b1, w2 = net["w1"], net["b1"], net["w2"]
+    logits, accs = [], []
+    for feats in cand_feats:
+        acc = list(b1)
+        for f in feats:
+            row = w1[f]
+            for i in range(HIDDEN):
+                acc[i] += row[i]
+        s = 0.0
+        for i in range(HIDDEN):
+            s += min(max(acc[i], 0.0), QA) * w2[i]
+        logits.append(s * OUT_K)
+        accs.append(acc)
+    return logits, accs
+
+
+def softmax(z):
+    m = max(z)
+    e = [math.exp(x - m) for x in z]
+    t = sum(e)
+    return [x / t for x in e]
+
+
+class Adam:
+    """逐参数 Adam；第一层只更新本批出现过的特征行（稀疏）。"""
+
+    def __init__(self, lr: float):
+        self.lr, self.b1, self.b2, self.eps = lr, 0.9, 0.999, 1e-8
+        self.m, self.v, self.t = {}, {}, 0
+
+    def step(self, key, params, grads):
+        m = self.m.setdefault(key, [0.0] * len(params))
+        v = self.v.setdefault(key, [0.0] * len(params))
+        c1 = 1 - self.b1 ** self.t
+        c2 = 1 - self.b2 ** self.t
+        for i, g in enumerate(grads):
+            m[i] = self.b1 * m[i] + (1 - self.b1) * g
+            v[i] = self.b2 * v[i] + (1 - self.b2) * g * g
+            params[i] -= self.lr * (m[i] / c1) / (math.sqrt(v[i] / c2) + self.eps)
+
+
+def evaluate(net, samples, top_k: int):
+    """平均交叉熵、第一选择命中率、着法落在前 top_k 内的比例，以及平均候选数。"""
+    loss = top1 = topk = cands = 0.0
+    for cand_feats, label in samples:
+        logits, _ = forward(net, cand_feats)
+        p = softmax(logits)
+        loss -= math.log(max(p[label], 1e-12))
+        rank = sum(1 for z in logits if z > logits[label])
+        top1 += rank == 0
+        topk += rank < top_k
+        cands += len(logits)
+    n = max(1, len(samples))
+    return loss / n, top1 / n, topk / n, cands / n
+
+
+def train(net, positions, epochs: int, batch: int, lr: float, val_frac: float, top_k: int, seed: int):
+    rng = random.Random(seed)
+    rng.shuffle(positions)
+    n_val = int(len(positions) * val_frac)
+    val = [s for s in (make_sample(b, l, 0) for b, l in positions[:n_val]) if s]
+    data = positions[n_val:]
+    opt = Adam(lr)
+    print(f"positions {len(data)} validation {len(val)}")
+
+    def report(epoch):
+        if val:
+            loss, top1, topk, cands = evaluate(net, val, top_k)
+            print(f"epoch {epoch} val-loss {loss:.4f} top1 {top1 * 100:.1f}% top{top_k} {topk * 100:.1f}% "
+                  f"(of {cands:.1f} candidates)")
+        else:
+            print(f"epoch {epoch}")
+
+    report(0)
+    for epoch in range(1, epochs + 1):
+        rng.shuffle(data)
+        for start in range(0, len(data), batch):
+            chunk = [s for s in (make_sample(b, l, rng.randrange(8)) for b, l in data[start:start + batch]) if s]
+            if not chunk:
+                continue
+            gw1 = {}
+            gb1 = [0.0] * HIDDEN
+            gw2 = [0.0] * HIDDEN
+            w2 = net["w2"]
+            for cand_feats, label in chunk:
+                logits, accs = forward(net, cand_feats)
+                p = softmax(logits)
+                for j, feats in enumerate(cand_feats):
+                    dz = (p[j] - (1.0 if j == label else 0.0)) * OUT_K / len(chunk)
+                    if abs(dz) < 1e-9:
+                        continue
+                    acc = accs[j]
+                    g_acc = [0.0] * HIDDEN
+                    for i in range(HIDDEN):
+                        a = acc[i]
+                        if a <= 0.0:
+                            continue
+                        gw2[i] += dz * min(a, QA)
+                        if a < QA:
+                            g_acc[i] = dz * w2[i]
+                    for i in range(HIDDEN):
+                        gb1[i] += g_acc[i]
+                    for f in feats:
+                        row = gw1.setdefault(f, [0.0] * HIDDEN)
+                        for i in range(HIDDEN):
+                            row[i] += g_acc[i]
+            opt.t += 1
+            for f, g in gw1.items():
+                opt.step(("w1", f), net["w1"][f], g)
+            opt.step("b1", net["b1"], gb1)
+            opt.step("w2", net["w2"], gw2)
+            # 导出为 int8：训练中就保持在可表示范围内
+            for row in gw1:
+                net["w1"][row] = [min(max(w, -127.0), 127.0) for w in net["w1"][row]]
+            net["w2"] = [min(max(w, -127.0), 127.0) for w in net["w2"]]
+        report(epoch)
+    return net
+
+
+def quantize(x: float, lo: int, hi: int) -> int:
+    return max(lo, min(hi, int(round(x))))
+
+
+def export_header(net, source: str, path: str) -> None:
+    def row(values):
+        return "{" + ",".join(str(v) for v in values) + "}"
+
+    w1 = [[quantize(x, -127, 127) for x in r] for r in net["w1"]]
+    b1 = [quantize(x, -32767, 32767) for x in net["b1"]]
+    w2 = [quantize(x, -127, 127) for x in net["w2"]]
+    lines = [
+        f"/* 由 tools/gomoku_policy/policy.py 生成，勿手改（网络：{source}） */",
+        "#ifndef PICO_CODE_GOMOKU_POLICY_NET_H",
+        "#define PICO_CODE_GOMOKU_POLICY_NET_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        f"#define GMK_POLICY_NET_FEATURES {FEATURES}",
+        f"#define GMK_POLICY_NET_HIDDEN {HIDDEN}",
+        "",
+        f"static const int8_t gmk_policy_w1[{FEATURES}][{HIDDEN}] = {{",
+    ]
+    lines += [row(r) + "," for r in w1]
+    lines += [
+        "};",
+        f"static const int16_t gmk_policy_b1[{HIDDEN}] = {row(b1)};",
+        f"static const int8_t gmk_policy_w2[{HIDDEN}] = {row(w2)};",
+        "",
+        "#endif /* PICO_CODE_GOMOKU_POLICY_NET_H */",
+        "",
+    ]
+    with open(path, "w") as f:
+        f.write("\n".join(lines))
+
+
+def main() -> None:
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = ap.add_subparsers(dest="cmd", required=True)
+    ex = sub.add_parser("export", help="write gomoku_policy_net.h")
+    ex.add_argument("--net", help="trained network (JSON); default: policy_net.json next to this script")
+    ex.add_argument("-o", "--output", required=True)
+    tr = sub.add_parser("train", help="train on 'board | cell' lines")
+    tr.add_argument("data")
+    tr.add_argument("-o", "--output", required=True)
+    tr.add_argument("--init", help="start from this network (default: random)")
+    tr.add_argument("--epochs", type=int, default=6)
+    tr.add_argument("--batch", type=int, default=64)
+    tr.add_argument("--lr", type=float, default=0.5)
+    tr.add_argument("--val", type=float, default=0.1, help="fraction held out for validation")
+    tr.add_argument("--top-k", type=int, default=12, help="report how often the move is in the top K")
+    tr.add_argument("--seed", type=int, default=1)
+    args = ap.parse_args()
+
+    if args.cmd == "export":
+        path = args.net or DEFAULT_NET
+        export_header(load_net(path), os.path.basename(path), args.output)
+        return
+    net = load_net(args.init) if args.init else random_net(args.seed)
+    positions = []
+    with open(args.data) as f:
+        for line in f:
+            if "|" in line and not line.startswith("#"):
+                positions.append(parse_line(line))
+    if not positions:
+        sys.exit(f"{args.data}: no 'board | cell' lines")
+    net = train(net, positions, args.epochs, args.batch, args.lr, args.val, args.top_k, args.seed)
+    with open(args.output, "w") as f:
+        json.dump({k: ([[round(x, 3) for x in r] for r in v] if k == "w1" else [round(x, 3) for x in v])
+                   for k, v in net.items()}, f)
+
+
+if __name__ == "__main__":
+    main()
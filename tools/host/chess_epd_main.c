@@ -0,0 +1,54 @@
+/**
+ * @file chess_epd_main.c
+ * @brief 主机版 EPD 测试集运行器：chess_epd <file.epd> [-d depth] [-n nodes] [-t movetime_ms] [-m N]
+ *
+ * -m N 为解题模式：用杀棋求解器在 N 步内找杀（可配合 EPD 的 dm 操作）。
+ * 每个局面输出一行结果，最后输出解出率与 nps 汇总（与设备 UCI epd 命令格式相同）。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "game/chess_search.h"
+#include "game/chess_engine.h"
+#include "game/chess_epd.h"
+
+#define EPD_DEFAULT_MOVETIME_MS 1000
+#define EPD_LINE_MAX 1024
+
+static void usage(void) {
+    fprintf(stderr, "usage: chess_epd <file.epd> [-d depth] [-n nodes] [-t movetime_ms] [-m mate_moves]\n");
+}
+
+int main(int argc, char **argv) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    const char *path = NULL;
+    int mate = 0;
+    ChessSearchLimits limits;
+    chess_search_limits_init(&limits);
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-d") == 0)      limits.depth = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-n") == 0) limits.nodes = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else if (i + 1 < argc && strcmp(argv[i], "-t") == 0) limits.movetime_ms = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else if (i + 1 < argc && strcmp(argv[i], "-m") == 0) mate = atoi(argv[++i]);
+        else if (argv[i][0] != '-' && !path)                 path = argv[i];
+        else { usage(); return 2; }
+    }
+    if (!path) { usage(); return 2; }
+    if (mate == 0 && limits.depth == 0 && limits.nodes == 0 && limits.movetime_ms == 0)
+        limits.movetime_ms = EPD_DEFAULT_MOVETIME_MS;
+
+    FILE *f = fopen(path, "r");
+    if (!f) { perror(path); return 1; }
+    static ChessEngine engine;
+    chess_engine_init(&engine, 0);
+    ChessEpdSummary sum;
+    chess_epd_summary_clear(&sum);
+    char line[EPD_LINE_MAX];
+    while (fgets(line, sizeof(line), f))
+        chess_epd_run_line(&engine, line, &limits, mate, &sum);
+    fclose(f);
+    chess_epd_print_summary(&sum);
+    return 0;
+}
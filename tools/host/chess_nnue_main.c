@@ -0,0 +1,171 @@
+/**
+ * @file chess_nnue_main.c
+ * @brief 主机版网络评估工具（以 -DCHESS_NNUE=ON 构建）：
+ *        chess_nnue bench [-n positions] [-r rounds]            子力评估 / 网络全量 / 网络增量 的每秒评估数
+ *        chess_nnue data [-g games] [-d depth] [-p random_plies] [-s seed]   输出 "FEN | 分数" 训练数据
+ *
+ * bench 的局面来自随机对局；同时校验增量更新与全量计算结果一致。
+ * data 让引擎自对弈（开局若干步及之后约 1/4 的步随机），每步以 depth 层搜索分数（行棋方视角）作标签，
+ * 跳过被将军与杀棋分的局面。输出交给 tools/chess_nnue/nnue.py train。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "game/chess_state.h"
+#include "game/chess_move.h"
+#include "game/chess_legal.h"
+#include "game/chess_result.h"
+#include "game/chess_check.h"
+#include "game/chess_eval.h"
+#include "game/chess_nnue.h"
+#include "game/chess_notation.h"
+#include "game/chess_search.h"
+#include "game/chess_engine.h"
+#include "game/game_clock.h"
+
+#define BENCH_DEFAULT_POSITIONS 4096
+#define BENCH_DEFAULT_ROUNDS    200
+#define GAME_MAX_PLIES          200
+
+static ChessEngine s_engine;
+
+static void usage(void) {
+    fprintf(stderr, "usage: chess_nnue bench [-n positions] [-r rounds]\n"
+                    "       chess_nnue data [-g games] [-d depth] [-p random_plies] [-s seed]\n");
+}
+
+/* 随机对局中的一个局面与其一步合法着法 */
+typedef struct {
+    ChessBoardState before;
+    ChessMove move;
+    ChessBoardState after;
+    ChessNnueAcc acc;       /* before 的累加器 */
+} BenchItem;
+
+static int random_move(const ChessBoardState *b, ChessMove *out) {
+    ChessAllMovesList list;
+    chess_all_legal_moves(b, &list);
+    if (list.count == 0) return 0;
+    *out = list.moves[chess_engine_rand(&s_engine) % (uint32_t)list.count];
+    return 1;
+}
+
+static void print_rate(const char *name, uint32_t evals, uint64_t us, int64_t checksum) {
+    printf("bench %-8s evals %lu time %lums evals/s %lu (checksum %lld)\n", name, (unsigned long)evals,
+           (unsigned long)(us / 1000), us ? (unsigned long)((uint64_t)evals * 1000000u / us) : 0ul,
+           (long long)checksum);
+}
+
+static int run_bench(int n, int rounds) {
+    BenchItem *items = (BenchItem *)malloc((size_t)n * sizeof(BenchItem));
+    if (!items) return 1;
+    ChessBoardState b;
+    chess_state_init_from_initial(&b);
+    for (int i = 0, ply = 0; i < n; ply++) {
+        ChessMove m;
+        if (ply >= GAME_MAX_PLIES || !random_move(&b, &m)) {
+            chess_state_init_from_initial(&b);
+            ply = -1;
+            continue;
+        }
+        items[i].before = b;
+        items[i].move = m;
+        chess_do_move(&b, &m);
+        items[i].after = b;
+        chess_nnue_refresh(&items[i].acc, &items[i].before);
+        i++;
+    }
+
+    /* 校验：增量 = 全量；子力等价网络下网络分 = 子力分 */
+    int mismatch = 0, same_as_material = 0;
+    for (int i = 0; i < n; i++) {
+        ChessNnueAcc inc, full;
+        chess_nnue_update(&inc, &items[i].acc, &items[i].before, &items[i].move);
+        chess_nnue_refresh(&full, &items[i].after);
+        if (memcmp(&inc, &full, sizeof(inc)) != 0) mismatch++;
+        int side = items[i].after.side_to_move;
+        if (chess_nnue_evaluate(&full, side) == chess_eval_material(&items[i].after, side)) same_as_material++;
+    }
+    printf("bench positions %d incremental-mismatch %d equal-to-material %d\n", n, mismatch, same_as_material);
+
+    uint32_t evals = (uint32_t)n * (uint32_t)rounds;
+    int64_t sum = 0;
+    uint64_t t0 = game_clock_us();
+    for (int r = 0; r < rounds; r++)
+        for (int i = 0; i < n; i++)
+            sum += chess_eval_material(&items[i].after, items[i].after.side_to_move);
+    print_rate("material", evals, game_clock_us() - t0, sum);
+
+    sum = 0;
+    t0 = game_clock_us();
+    for (int r = 0; r < rounds; r++)
+        for (int i = 0; i < n; i++)
+            sum += chess_nnue_eval(&items[i].after, items[i].after.side_to_move);
+    print_rate("nnue-full", evals, game_clock_us() - t0, sum);
+
+    /* 搜索中的用法：走一步时从父层累加器增量更新，再求值 */
+    sum = 0;
+    t0 = game_clock_us();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < n; i++) {
+            ChessNnueAcc child;
+            chess_nnue_update(&child, &items[i].acc, &items[i].before, &items[i].move);
+            sum += chess_nnue_evaluate(&child, items[i].after.side_to_move);
+        }
+    }
+    print_rate("nnue-inc", evals, game_clock_us() - t0, sum);
+    free(items);
+    return mismatch != 0;
+}
+
+static int run_data(int games, int depth, int random_plies) {
+    ChessSearchLimits limits;
+    chess_search_limits_init(&limits);
+    limits.depth = depth;
+    unsigned long written = 0;
+    char fen[100];
+    for (int g = 0; g < games; g++) {
+        ChessBoardState b;
+        chess_state_init_from_initial(&b);
+        chess_engine_new_game(&s_engine);
+        for (int ply = 0; ply < GAME_MAX_PLIES; ply++) {
+            ChessSearchResult res;
+            if (!chess_search_run(&s_engine, &b, &limits, &res)) break;
+            int score = res.info.score;
+            if (!chess_is_king_in_check(&b, b.side_to_move) && score < CHESS_SEARCH_MATE_BOUND &&
+                score > -CHESS_SEARCH_MATE_BOUND) {
+                chess_state_to_fen(&b, fen, sizeof(fen));
+                printf("%s | %d\n", fen, score);
+                written++;
+            }
+            ChessMove m = res.best;
+            if (ply < random_plies || chess_engine_rand(&s_engine) % 4 == 0) random_move(&b, &m);
+            chess_do_move(&b, &m);
+        }
+    }
+    fprintf(stderr, "data games %d positions %lu\n", games, written);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    if (argc < 2) { usage(); return 2; }
+    int n = BENCH_DEFAULT_POSITIONS, rounds = BENCH_DEFAULT_ROUNDS;
+    int games = 100, depth = 3, random_plies = 8;
+    uint32_t seed = 0;
+    for (int i = 2; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-n") == 0)      n = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-r") == 0) rounds = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-g") == 0) games = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-d") == 0) depth = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-p") == 0) random_plies = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else { usage(); return 2; }
+    }
+    chess_engine_init(&s_engine, seed);
+    if (strcmp(argv[1], "bench") == 0 && n > 0 && rounds > 0) return run_bench(n, rounds);
+    if (strcmp(argv[1], "data") == 0 && games > 0 && depth > 0) return run_data(games, depth, random_plies);
+    usage();
+    return 2;
+}
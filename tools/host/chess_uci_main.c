@@ -0,0 +1,19 @@
+/**
+ * @file chess_uci_main.c
+ * @brief 主机版 UCI 引擎：与设备同一套 chess_* 代码，供 cutechess/fastchess 等工具对弈与测速
+ */
+
+#include <stdio.h>
+#include "game/chess_engine.h"
+#include "game/chess_uci.h"
+#include "host_io.h"
+
+int main(void) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    static ChessEngine engine;
+    static ChessUci uci;
+    chess_engine_init(&engine, 0);
+    chess_uci_init(&uci, &engine, host_read_line, NULL);
+    chess_uci_loop(&uci);
+    return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file gomoku_bench_main.c
+ * @brief 主机版五子棋搜索基准：gomoku_bench [-d depth] [-t ms] [-j workers] [-g games] [-s seed]
+ *
+ * 人类一方用固定种子的伪随机着法（已有子周围 1 格内的空位），AI 按 depth 层搜索（给了 -t 时按每步 ms 毫秒迭代加深，depth 为上限）；
+ * -j 为根节点并行的线程数（默认 1）。
+ * 输出 AI 的总节点数、平均完成层数、搜索时间与每秒节点数、候选生成的每节点耗时、置换表命中率、VCF 节点数，以及 AI 着法的校验和（改动搜索后用来确认着法不变）。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "game/gomoku_game.h"
+
+#define BENCH_MAX_AI_MOVES 30
+
+static uint32_t s_rng;
+
+static uint32_t bench_rand(void) {
+  s_rng = s_rng * 1664525u + 1013904223u;
+  return s_rng >> 8;
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: gomoku_bench [-d depth] [-t ms] [-j workers] [-g games] [-s seed]\n");
+}
+
+/* 随机选一个已有子周围 1 格内的空位；空盘时下天元 */
+static void human_move(const GmkGameState *g, int *out_r, int *out_c) {
+  int cells[GOMOKU_SIZE * GOMOKU_SIZE];
+  int n = 0;
+  for (int r = 0; r < GOMOKU_SIZE; r++) {
+    for (int c = 0; c < GOMOKU_SIZE; c++) {
+      if (gmk_game_cell(g, r, c) != 0) continue;
+      bool near = false;
+      for (int dr = -1; dr <= 1 && !near; dr++)
+        for (int dc = -1; dc <= 1 && !near; dc++)
+          if (gmk_game_cell(g, r + dr, c + dc) != 0) near = true;
+      if (near) cells[n++] = r * GOMOKU_SIZE + c;
+    }
+  }
+  int cell = n ? cells[bench_rand() % (uint32_t)n] : (GOMOKU_SIZE / 2) * (GOMOKU_SIZE + 1);
+  *out_r = cell / GOMOKU_SIZE;
+  *out_c = cell % GOMOKU_SIZE;
+}
+
+int main(int argc, char **argv) {
+  int depth = 3, games = 8, budget_ms = 0, workers = 1;
+  uint32_t seed = 1;
+  for (int i = 1; i < argc; i++) {
+    if (i + 1 < argc && strcmp(argv[i], "-d") == 0)      depth = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-t") == 0) budget_ms = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-j") == 0) workers = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-g") == 0) games = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+    else { usage(); return 2; }
+  }
+  if (depth < 1 || games < 1 || budget_ms < 0 || budget_ms > 60000 || workers < 1 || workers > 255) { usage(); return 2; }
+  s_rng = seed;
+
+  static GmkGameState g;
+  GmkAiContext *ai = gmk_ai_context_new(false, workers);
+  if (!ai) { fprintf(stderr, "gomoku_bench: out of memory\n"); return 1; }
+  unsigned long moves = 0, searched = 0;
+  uint64_t nodes = 0, us = 0, gen_us = 0, tt_probes = 0, tt_hits = 0, tt_cuts = 0, vcf_nodes = 0, depths = 0;
+  uint32_t checksum = 0;
+  for (int game = 0; game < games; game++) {
+    gmk_game_init(&g, ai);
+    g.ai_depth = (uint8_t)depth;
+    g.ai_budget_ms = (uint16_t)budget_ms;
+    g.ai_workers = (uint8_t)workers;
+    for (int m = 0; m < BENCH_MAX_AI_MOVES && !gmk_game_is_over(&g); m++) {
+      int r, c;
+      human_move(&g, &r, &c);
+      if (!gmk_game_place_human(&g, r, c) || gmk_game_is_over(&g)) break;
+      if (!gmk_game_ai_move(&g, &r, &c)) break;
+      checksum = checksum * 31u + (uint32_t)(r * GOMOKU_SIZE + c);
+      moves++;
+      if (g.last_stats.nodes) {
+        searched++;
+        depths += g.last_stats.depth;
+      }
+      nodes += g.last_stats.nodes;
+      us += g.last_stats.elapsed_us;
+      gen_us += g.last_stats.gen_us;
+      tt_probes += g.last_stats.tt_probes;
+      tt_hits += g.last_stats.tt_hits;
+      tt_cuts += g.last_stats.tt_cuts;
+      vcf_nodes += g.last_stats.vcf_nodes;
+    }
+  }
+  printf("bench depth %d budget %dms workers %d games %d ai-moves %lu searched %lu avg-depth %.2f nodes %llu time %llums nodes/s %llu "
+         "gen %llums (%lluns/node) tt-hit %llu%% tt-cut %llu%% vcf %llu checksum %08lx\n",
+         depth, budget_ms, workers, games, moves, searched, searched ? (double)depths / (double)searched : 0.0,
+         (unsigned long long)nodes, (unsigned long long)(us / 1000),
+         (unsigned long long)(us ? nodes * 1000000u / us : 0), (unsigned long long)(gen_us / 1000),
+         (unsigned long long)(nodes ? gen_us * 1000u / nodes : 0),
+         (unsigned long long)(tt_probes ? tt_hits * 100u / tt_probes : 0),
+         (unsigned long long)(tt_probes ? tt_cuts * 100u / tt_probes : 0), (unsigned long long)vcf_nodes,
+         (unsigned long)checksum);
+  gmk_ai_context_free(ai);
+  return 0;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file gomoku_mcts_main.c
+ * @brief 主机版五子棋 MCTS 对 Alpha-Beta：gomoku_mcts [-p playouts] [-j threads] [-g games] [-d depth] [-s seed]
+ *
+ * 每局先在中央随机摆 3 子开局，两局一组交换先后手；MCTS 方每步 playouts 次模拟，
+ * threads > 1 时为根并行（各线程独立建树，合并根着法的访问次数后取最多者），成五/挡五直接走；
+ * Alpha-Beta 方为 gmk_game_ai_move 按 depth 层搜索。输出 MCTS 每秒模拟次数与胜/负/和。
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "game/game_clock.h"
+#include "game/gomoku_game.h"
+#include "game/gomoku_mcts.h"
+
+#define MCTS_MAX_THREADS 16
+#define MATCH_MAX_PLIES  (GOMOKU_SIZE * GOMOKU_SIZE)
+
+typedef struct {
+  GmkMcts *ctx;
+  const uint8_t (*board)[GOMOKU_SIZE];
+  uint32_t seed;
+  uint32_t playouts;
+} Worker;
+
+static uint32_t s_rng;
+
+static uint32_t match_rand(void) {
+  s_rng = s_rng * 1664525u + 1013904223u;
+  return s_rng >> 8;
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: gomoku_mcts [-p playouts] [-j threads] [-g games] [-d depth] [-s seed]\n");
+}
+
+static void *worker_run(void *arg) {
+  Worker *w = arg;
+  gmk_mcts_init(w->ctx, w->board, w->seed);
+  gmk_mcts_run(w->ctx, w->playouts, 0);
+  return NULL;
+}
+
+/* board 以 2 为 MCTS 方；返回 r*15+c，累加本步的模拟次数 */
+static int mcts_move(Worker *workers, int threads, const uint8_t board[GOMOKU_SIZE][GOMOKU_SIZE],
+                     uint32_t playouts, uint64_t *total_playouts) {
+  static GmkSearch pos;
+  int r, c;
+  gmk_search_init(&pos, board);
+  if (gmk_search_first_threat(&pos, AI_PLAYER, THREAT_FIVE, &r, &c)) return r * GOMOKU_SIZE + c;
+  if (gmk_search_first_threat(&pos, HU_PLAYER, THREAT_FIVE, &r, &c)) return r * GOMOKU_SIZE + c;
+
+  pthread_t tid[MCTS_MAX_THREADS];
+  uint32_t seed = (uint32_t)pos.keys[0];
+  for (int t = 0; t < threads; t++) {
+    workers[t].board = board;
+    workers[t].seed = (seed ^ (uint32_t)(t + 1) * 0x9E3779B9u) | 1u;
+    workers[t].playouts = playouts;
+  }
+  for (int t = 1; t < threads; t++) pthread_create(&tid[t], NULL, worker_run, &workers[t]);
+  worker_run(&workers[0]);
+  for (int t = 1; t < threads; t++) pthread_join(tid[t], NULL);
+
+  uint32_t visits[GOMOKU_SIZE * GOMOKU_SIZE] = { 0 };
+  for (int t = 0; t < threads; t++) {
+    gmk_mcts_root_visits(workers[t].ctx, visits);
+    *total_playouts += workers[t].ctx->playouts;
+  }
+  int best = -1;
+  for (int i = 0; i < GOMOKU_SIZE * GOMOKU_SIZE; i++)
+    if (visits[i] && (best < 0 || visits[i] > visits[best])) best = i;
+  return best;
+}
+
+static bool five_at(const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE], int r, int c) {
+  static const int dr[4] = { 0, 1, 1, 1 }, dc[4] = { 1, 0, 1, -1 };
+  for (int d = 0; d < 4; d++) {
+    int n = 1;
+    for (int s = -1; s <= 1; s += 2) {
+      int rr = r + s * dr[d], cc = c + s * dc[d];
+      while (rr >= 0 && rr < GOMOKU_SIZE && cc >= 0 && cc < GOMOKU_SIZE && b[rr][cc] == b[r][c]) {
+        n++;
+        rr += s * dr[d];
+        cc += s * dc[d];
+      }
+    }
+    if (n >= 5) return true;
+  }
+  return false;
+}
+
+int main(int argc, char **argv) {
+  int playouts = 20000, threads = 1, games = 10, depth = 3;
+  uint32_t seed = 1;
+  for (int i = 1; i < argc; i++) {
+    if (i + 1 < argc && strcmp(argv[i], "-p") == 0)      playouts = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-j") == 0) threads = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-g") == 0) games = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-d") == 0) depth = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+    else { usage(); return 2; }
+  }
+  if (playouts < 1 || threads < 1 || threads > MCTS_MAX_THREADS || games < 1 || depth < 1) { usage(); return 2; }
+
+  Worker workers[MCTS_MAX_THREADS];
+  for (int t = 0; t < threads; t++) {
+    workers[t].ctx = malloc(sizeof(GmkMcts));
+    if (!workers[t].ctx) { fprintf(stderr, "gomoku_mcts: out of memory\n"); return 1; }
+  }
+
+  static GmkGameState g;
+  GmkAiContext *ai = gmk_ai_context_new(false, GMK_WORKERS);
+  if (!ai) { fprintf(stderr, "gomoku_mcts: out of memory\n"); return 1; }
+  int wins = 0, losses = 0, draws = 0;
+  uint64_t total_playouts = 0, mcts_us = 0, ab_us = 0;
+  unsigned long mcts_moves = 0;
+  for (int game = 0; game < games; game++) {
+    /* 两局一组用同一开局，MCTS 分别执先后手；棋盘上 1 = 先手 */
+    s_rng = seed + (uint32_t)(game / 2);
+    uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE];
+    memset(b, 0, sizeof(b));
+    uint8_t p = 1;
+    for (int placed = 0; placed < 3;) {
+      int r = GOMOKU_SIZE / 2 - 2 + (int)(match_rand() % 5), c = GOMOKU_SIZE / 2 - 2 + (int)(match_rand() % 5);
+      if (b[r][c]) continue;
+      b[r][c] = p;
+      p = (uint8_t)(3 - p);
+      placed++;
+    }
+    uint8_t mcts_side = (game & 1) ? 1 : 2;
+    int result = 0;   /* 1 MCTS 胜，2 Alpha-Beta 胜，3 和 */
+    for (int ply = 0; ply < MATCH_MAX_PLIES && !result; ply++) {
+      /* 换成走棋方视角：自己为 2（AI），对方为 1 */
+      uint8_t view[GOMOKU_SIZE][GOMOKU_SIZE];
+      bool any_empty = false;
+      for (int r = 0; r < GOMOKU_SIZE; r++)
+        for (int c = 0; c < GOMOKU_SIZE; c++) {
+          view[r][c] = b[r][c] == 0 ? 0 : b[r][c] == p ? AI_PLAYER : HU_PLAYER;
+          if (!b[r][c]) any_empty = true;
+        }
+      if (!any_empty) { result = 3; break; }
+      int cell;
+      uint64_t t0 = game_clock_us();
+      if (p == mcts_side) {
+        cell = mcts_move(workers, threads, (const uint8_t (*)[GOMOKU_SIZE])view, (uint32_t)playouts, &total_playouts);
+        mcts_us += game_clock_us() - t0;
+        mcts_moves++;
+      } else {
+        gmk_game_init(&g, ai);
+        g.ai_depth = (uint8_t)depth;
+        memcpy(g.board, view, sizeof(view));
+        g.cur_player = AI_PLAYER;
+        int r, c;
+        cell = gmk_game_ai_move(&g, &r, &c) ? r * GOMOKU_SIZE + c : -1;
+        ab_us += game_clock_us() - t0;
+      }
+      if (cell < 0) { result = 3; break; }
+      b[cell / GOMOKU_SIZE][cell % GOMOKU_SIZE] = p;
+      if (five_at((const uint8_t (*)[GOMOKU_SIZE])b, cell / GOMOKU_SIZE, cell % GOMOKU_SIZE))
+        result = p == mcts_side ? 1 : 2;
+      p = (uint8_t)(3 - p);
+    }
+    if (!result) result = 3;
+    if (result == 1) wins++;
+    else if (result == 2) losses++;
+    else draws++;
+  }
+  for (int t = 0; t < threads; t++) free(workers[t].ctx);
+  gmk_ai_context_free(ai);
+
+  printf("mcts playouts %d threads %d nodes %d vs alphabeta depth %d games %d: win %d loss %d draw %d "
+         "(%.1f%%) playouts/s %llu mcts %llums/move alphabeta %llums total\n",
+         playouts, threads, GMK_MCTS_NODES, depth, games, wins, losses, draws,
+         100.0 * (wins + 0.5 * draws) / games,
+         (unsigned long long)(mcts_us ? total_playouts * 1000000u / mcts_us : 0),
+         (unsigned long long)(mcts_moves ? mcts_us / 1000u / mcts_moves : 0),
+         (unsigned long long)(ab_us / 1000u));
+  return 0;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file gomoku_policy_main.c
+ * @brief 主机版五子棋策略网络工具（以 -DGOMOKU_POLICY=ON 构建）：
+ *        gomoku_policy bench [-n positions] [-s seed]                         每个候选格的推理耗时
+ *        gomoku_policy data [-g games] [-d depth] [-p random_plies] [-s seed]  输出 "棋盘 | 格号" 训练数据
+ *        gomoku_policy match [-g games] [-d depth] [-f full_depth] [-k top_k] [-s seed]  剪枝（只展开前 k 个）对不剪的节点数与胜负
+ *
+ * bench 的局面来自随机对局，对每个局面的全部候选格求 logit。
+ * data 让 Alpha-Beta 自对弈（开局若干步及之后约 1/4 的步随机），每个经过搜索的局面以 depth 层搜索选中的着法作标签；
+ * 棋盘 225 个字符，'x' 为走棋方、'o' 为对方、'.' 为空。输出交给 tools/gomoku_policy/policy.py train。
+ * match 每局先在中央随机摆 3 子，两局一组交换先后手；剪枝方搜 depth 层，不剪方搜 full_depth 层（默认同 depth）。
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "game/game_clock.h"
+#include "game/gomoku_game.h"
+#include "game/gomoku_policy.h"
+
+#define MATCH_MAX_PLIES (GOMOKU_SIZE * GOMOKU_SIZE)
+
+static uint32_t s_rng;
+static GmkGameState s_game;
+static GmkAiContext *s_ai;
+static GmkSearch s_search;
+
+static uint32_t tool_rand(void) {
+  s_rng = s_rng * 1664525u + 1013904223u;
+  return s_rng >> 8;
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: gomoku_policy bench [-n positions] [-s seed]\n"
+                  "       gomoku_policy data [-g games] [-d depth] [-p random_plies] [-s seed]\n"
+                  "       gomoku_policy match [-g games] [-d depth] [-f full_depth] [-k top_k] [-s seed]\n");
+}
+
+/* 已有子周围 1 格内的随机空位；空盘时下天元 */
+static int random_cell(const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE]) {
+  int cells[GOMOKU_SIZE * GOMOKU_SIZE], n = 0;
+  for (int r = 0; r < GOMOKU_SIZE; r++)
+    for (int c = 0; c < GOMOKU_SIZE; c++) {
+      if (b[r][c]) continue;
+      bool near = false;
+      for (int dr = -1; dr <= 1 && !near; dr++)
+        for (int dc = -1; dc <= 1 && !near; dc++) {
+          int rr = r + dr, cc = c + dc;
+          if (rr >= 0 && rr < GOMOKU_SIZE && cc >= 0 && cc < GOMOKU_SIZE && b[rr][cc]) near = true;
+        }
+      if (near) cells[n++] = r * GOMOKU_SIZE + c;
+    }
+  return n ? cells[tool_rand() % (uint32_t)n] : (GOMOKU_SIZE / 2) * (GOMOKU_SIZE + 1);
+}
+
+static bool five_at(const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE], int r, int c) {
+  static const int dr[4] = { 0, 1, 1, 1 }, dc[4] = { 1, 0, 1, -1 };
+  for (int d = 0; d < 4; d++) {
+    int n = 1;
+    for (int s = -1; s <= 1; s += 2) {
+      int rr = r + s * dr[d], cc = c + s * dc[d];
+      while (rr >= 0 && rr < GOMOKU_SIZE && cc >= 0 && cc < GOMOKU_SIZE && b[rr][cc] == b[r][c]) {
+        n++;
+        rr += s * dr[d];
+        cc += s * dc[d];
+      }
+    }
+    if (n >= 5) return true;
+  }
+  return false;
+}
+
+/* 换成走棋方 p 的视角（自己为 AI）搜一步；返回格号，无着法返回 -1 */
+static int search_move(const uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE], uint8_t p, int depth, uint8_t policy_k) {
+  gmk_game_init(&s_game, s_ai);
+  s_game.ai_depth = (uint8_t)depth;
+  s_game.ai_policy_k = policy_k;
+  for (int r = 0; r < GOMOKU_SIZE; r++)
+    for (int c = 0; c < GOMOKU_SIZE; c++)
+      s_game.board[r][c] = b[r][c] == 0 ? 0 : b[r][c] == p ? AI_PLAYER : HU_PLAYER;
+  s_game.cur_player = AI_PLAYER;
+  int r, c;
+  return gmk_game_ai_move(&s_game, &r, &c) ? r * GOMOKU_SIZE + c : -1;
+}
+
+static int run_bench(int positions) {
+  uint64_t us = 0, evals = 0;
+  int64_t checksum = 0;
+  uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE];
+  int made = 0;
+  while (made < positions) {
+    memset(b, 0, sizeof(b));
+    int plies = 4 + (int)(tool_rand() % 40);
+    uint8_t p = 1;
+    for (int i = 0; i < plies; i++) {
+      int cell = random_cell((const uint8_t (*)[GOMOKU_SIZE])b);
+      b[cell / GOMOKU_SIZE][cell % GOMOKU_SIZE] = p;
+      p = (uint8_t)(3 - p);
+    }
+    gmk_search_init(&s_search, (const uint8_t (*)[GOMOKU_SIZE])b);
+    uint64_t t0 = game_clock_us();
+    for (int r = 0; r < GOMOKU_SIZE; r++)
+      for (uint16_t row = s_search.cand_rows[r]; row; row &= (uint16_t)(row - 1)) {
+        checksum += gmk_policy_logit(&s_search, r, __builtin_ctz(row), p);
+        evals++;
+      }
+    us += game_clock_us() - t0;
+    made++;
+  }
+  printf("bench policy positions %d cells %llu time %llums cells/s %llu (%.1f cells, %lluus per position; checksum %lld)\n",
+         positions, (unsigned long long)evals, (unsigned long long)(us / 1000),
+         (unsigned long long)(us ? evals * 1000000u / us : 0), (double)evals / positions,
+         (unsigned long long)(us / (uint64_t)positions), (long long)checksum);
+  return 0;
+}
+
+static int run_data(int games, int depth, int random_plies) {
+  uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE];
+  unsigned long lines = 0;
+  for (int game = 0; game < games; game++) {
+    memset(b, 0, sizeof(b));
+    uint8_t p = 1;
+    for (int ply = 0; ply < MATCH_MAX_PLIES; ply++) {
+      int cell;
+      if (ply < random_plies) {
+        cell = random_cell((const uint8_t (*)[GOMOKU_SIZE])b);
+      } else {
+        cell = search_move((const uint8_t (*)[GOMOKU_SIZE])b, p, depth, 0);
+        if (cell < 0) break;
+        if (s_game.last_stats.nodes) {
+          char text[GOMOKU_SIZE * GOMOKU_SIZE + 1];
+          for (int i = 0; i < GOMOKU_SIZE * GOMOKU_SIZE; i++) {
+            uint8_t v = b[i / GOMOKU_SIZE][i % GOMOKU_SIZE];
+            text[i] = v == 0 ? '.' : v == p ? 'x' : 'o';
+          }
+          text[GOMOKU_SIZE * GOMOKU_SIZE] = '\0';
+          printf("%s | %d\n", text, cell);
+          lines++;
+        }
+        if (tool_rand() % 4 == 0) cell = random_cell((const uint8_t (*)[GOMOKU_SIZE])b);
+      }
+      b[cell / GOMOKU_SIZE][cell % GOMOKU_SIZE] = p;
+      if (five_at((const uint8_t (*)[GOMOKU_SIZE])b, cell / GOMOKU_SIZE, cell % GOMOKU_SIZE)) break;
+      p = (uint8_t)(3 - p);
+    }
+  }
+  fprintf(stderr, "data games %d depth %d positions %lu\n", games, depth, lines);
+  return 0;
+}
+
+static int run_match(int games, int depth, int full_depth, int top_k, uint32_t seed) {
+  int wins = 0, losses = 0, draws = 0;
+  uint64_t nodes[2] = { 0, 0 }, us[2] = { 0, 0 }, moves[2] = { 0, 0 };
+  for (int game = 0; game < games; game++) {
+    /* 两局一组用同一开局，剪枝方分别执先后手；棋盘上 1 = 先手 */
+    s_rng = seed + (uint32_t)(game / 2);
+    uint8_t b[GOMOKU_SIZE][GOMOKU_SIZE];
+    memset(b, 0, sizeof(b));
+    uint8_t p = 1;
+    for (int placed = 0; placed < 3;) {
+      int r = GOMOKU_SIZE / 2 - 2 + (int)(tool_rand() % 5), c = GOMOKU_SIZE / 2 - 2 + (int)(tool_rand() % 5);
+      if (b[r][c]) continue;
+      b[r][c] = p;
+      p = (uint8_t)(3 - p);
+      placed++;
+    }
+    uint8_t pruned_side = (game & 1) ? 1 : 2;
+    int result = 0;   /* 1 剪枝方胜，2 不剪方胜，3 和 */
+    for (int ply = 0; ply < MATCH_MAX_PLIES && !result; ply++) {
+      int side = p == pruned_side ? 0 : 1;
+      uint64_t t0 = game_clock_us();
+      int cell = side == 0 ? search_move((const uint8_t (*)[GOMOKU_SIZE])b, p, depth, (uint8_t)top_k)
+                           : search_move((const uint8_t (*)[GOMOKU_SIZE])b, p, full_depth, 0);
+      us[side] += game_clock_us() - t0;
+      nodes[side] += s_game.last_stats.nodes;
+      moves[side]++;
+      if (cell < 0) { result = 3; break; }
+      b[cell / GOMOKU_SIZE][cell % GOMOKU_SIZE] = p;
+      if (five_at((const uint8_t (*)[GOMOKU_SIZE])b, cell / GOMOKU_SIZE, cell % GOMOKU_SIZE))
+        result = side == 0 ? 1 : 2;
+      p = (uint8_t)(3 - p);
+    }
+    if (!result) result = 3;
+    if (result == 1) wins++;
+    else if (result == 2) losses++;
+    else draws++;
+  }
+  printf("match depth %d top-k %d vs full depth %d, games %d: win %d loss %d draw %d (%.1f%%) "
+         "nodes/move %llu vs %llu time/move %llums vs %llums\n",
+         depth, top_k, full_depth, games, wins, losses, draws, 100.0 * (wins + 0.5 * draws) / games,
+         (unsigned long long)(moves[0] ? nodes[0] / moves[0] : 0), (unsigned long long)(moves[1] ? nodes[1] / moves[1] : 0),
+         (unsigned long long)(moves[0] ? us[0] / 1000u / moves[0] : 0), (unsigned long long)(moves[1] ? us[1] / 1000u / moves[1] : 0));
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) { usage(); return 2; }
+  int positions = 2000, games = 20, depth = 3, random_plies = 4, top_k = 0, full_depth = 0;
+  uint32_t seed = 1;
+  for (int i = 2; i < argc; i++) {
+    if (i + 1 < argc && strcmp(argv[i], "-n") == 0)      positions = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-g") == 0) games = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-d") == 0) depth = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-p") == 0) random_plies = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-f") == 0) full_depth = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-k") == 0) top_k = atoi(argv[++i]);
+    else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+    else { usage(); return 2; }
+  }
+  s_ai = gmk_ai_context_new(false, GMK_WORKERS);
+  if (!s_ai) { fprintf(stderr, "gomoku_policy: out of memory\n"); return 1; }
+  if (top_k == 0) {
+    gmk_game_init(&s_game, s_ai);   /* 默认取 GMK_POLICY_TOP_K */
+    top_k = s_game.ai_policy_k;
+  }
+  if (full_depth == 0) full_depth = depth;
+  if (positions < 1 || games < 1 || depth < 1 || full_depth < 1 || random_plies < 0 || top_k < 1 || top_k > 255) { usage(); return 2; }
+  s_rng = seed;
+  if (strcmp(argv[1], "bench") == 0) return run_bench(positions);
+  if (strcmp(argv[1], "data") == 0) return run_data(games, depth, random_plies);
+  if (strcmp(argv[1], "match") == 0) return run_match(games, depth, full_depth, top_k, seed);
+  usage();
+  return 2;
+}
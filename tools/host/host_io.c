@@ -0,0 +1,49 @@
+/**
+ * @file host_io.c
+ * @brief 直接读 fd 0 自行缓冲，避免 stdio 缓冲与 poll() 不一致
+ */
+
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include "host_io.h"
+
+static char s_buf[4096];
+static int s_len;
+static int s_eof;
+
+/* 缓冲中若有完整一行则取出 */
+static int take_line(char *buf, int size) {
+    for (int i = 0; i < s_len; i++) {
+        if (s_buf[i] != '\n') continue;
+        int n = i;
+        if (n > 0 && s_buf[n - 1] == '\r') n--;
+        if (n > size - 1) n = size - 1;
+        memcpy(buf, s_buf, (size_t)n);
+        buf[n] = '\0';
+        memmove(s_buf, s_buf + i + 1, (size_t)(s_len - i - 1));
+        s_len -= i + 1;
+        return 1;
+    }
+    return 0;
+}
+
+int host_read_line(char *buf, int size, int blocking, void *user) {
+    (void)user;
+    for (;;) {
+        if (take_line(buf, size)) return 1;
+        if (s_eof) {
+            if (s_len == 0) return -1;
+            s_buf[s_len++] = '\n';  /* 末行无换行 */
+            continue;
+        }
+        if (s_len == (int)sizeof(s_buf)) s_len = 0;  /* 超长行丢弃 */
+        if (!blocking) {
+            struct pollfd p = { 0, POLLIN, 0 };
+            if (poll(&p, 1, 0) <= 0) return 0;
+        }
+        ssize_t n = read(0, s_buf + s_len, sizeof(s_buf) - (size_t)s_len);
+        if (n <= 0) s_eof = 1;
+        else s_len += (int)n;
+    }
+}
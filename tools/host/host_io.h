@@ -0,0 +1,12 @@
+/**
+ * @file host_io.h
+ * @brief 主机工具的 stdin 行读取：阻塞/非阻塞两种方式（与 ChessUciReadLine 兼容）
+ */
+
+#ifndef PICO_CODE_HOST_IO_H
+#define PICO_CODE_HOST_IO_H
+
+/** 返回 1 读到一行（去掉 \r\n），0 暂无（仅非阻塞），-1 EOF */
+int host_read_line(char *buf, int size, int blocking, void *user);
+
+#endif /* PICO_CODE_HOST_IO_H */